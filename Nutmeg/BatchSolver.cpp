@@ -0,0 +1,150 @@
+#include "BatchSolver.h"
+#include "ModelPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <unistd.h>
+
+namespace Nutmeg
+{
+
+// Run a function on every index from 0 to size - 1 over a number of threads
+static void parallel_for(const Int nb_threads, const Int size, const std::function<void(Int)>& function)
+{
+    std::atomic<Int> next_idx{0};
+    auto worker = [&]()
+    {
+        for (Int idx = next_idx++; idx < size; idx = next_idx++)
+        {
+            function(idx);
+        }
+    };
+
+    Vector<std::thread> threads;
+    for (Int thread_idx = 1; thread_idx < std::min(nb_threads, size); ++thread_idx)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+BatchSolver::BatchSolver(const Int nb_threads, const Float memory_per_job) :
+    jobs_(),
+    nb_threads_(nb_threads)
+{
+    if (nb_threads_ <= 0)
+    {
+        // Use one thread per core.
+        nb_threads_ = std::max<Int>(1, std::thread::hardware_concurrency());
+
+        // Limit the threads by the memory available.
+        const auto nb_pages = sysconf(_SC_AVPHYS_PAGES);
+        const auto page_size = sysconf(_SC_PAGE_SIZE);
+        if (nb_pages > 0 && page_size > 0 && memory_per_job > 0)
+        {
+            const auto memory = static_cast<Float>(nb_pages) * static_cast<Float>(page_size);
+            const auto max_threads = static_cast<Int>(memory / memory_per_job);
+            nb_threads_ = std::max<Int>(1, std::min(nb_threads_, max_threads));
+        }
+    }
+}
+
+void BatchSolver::add_job(
+    const String& name,
+    ModelBuilder build,
+    const Float time_limit,
+    const Method method,
+    const Float predicted_cost
+)
+{
+    release_assert(build, "Job {} has no model builder", name);
+    jobs_.push_back(BatchJob{name, std::move(build), time_limit, method, predicted_cost});
+}
+
+void BatchSolver::run(std::function<void(const BatchResult&, Model&)> callback)
+{
+    // Order the jobs longest-predicted-first.
+    const Int nb_jobs = jobs_.size();
+    Vector<Int> order(nb_jobs);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const Int a, const Int b)
+    {
+        return jobs_[a].predicted_cost > jobs_[b].predicted_cost;
+    });
+
+    // Build and solve the models one job at a time in each worker, and stream the results. Models are
+    // taken from a pool and reset between jobs, so SCIP and its plugins are only set up once per worker.
+    ModelPool pool;
+    std::mutex callback_mutex;
+    parallel_for(nb_threads_, nb_jobs, [&](const Int order_idx)
+    {
+        const auto idx = order[order_idx];
+        const auto& job = jobs_[idx];
+        auto model = pool.acquire(job.method);
+
+        // Report an error unless the job finishes.
+        BatchResult result;
+        result.job_idx = idx;
+        result.name = job.name;
+        result.status = Status::Error;
+        result.primal_bound = std::numeric_limits<Float>::quiet_NaN();
+        result.dual_bound = std::numeric_limits<Float>::quiet_NaN();
+        result.run_time = 0;
+        result.predicted_cost = job.predicted_cost;
+
+        // Build and solve. An exception escaping a worker would terminate the process, so a failed job is
+        // reported as an error and its model, which can be half-built, is not reused.
+        bool is_reusable = true;
+        try
+        {
+            const auto obj_var = job.build(*model);
+            model->minimize(obj_var, job.time_limit, false);
+
+            result.status = model->get_status();
+            if (result.status == Status::Optimal || result.status == Status::Feasible)
+            {
+                result.primal_bound = model->get_primal_bound();
+            }
+            if (result.status != Status::Infeasible)
+            {
+                result.dual_bound = model->get_dual_bound();
+            }
+            result.run_time = model->get_runtime();
+        }
+        catch (const std::exception& e)
+        {
+            fmt::print(stderr, "Job {} failed: {}\n", job.name, e.what());
+            result.status = Status::Error;
+            is_reusable = false;
+        }
+        catch (...)
+        {
+            fmt::print(stderr, "Job {} failed\n", job.name);
+            result.status = Status::Error;
+            is_reusable = false;
+        }
+
+        // Report result.
+        if (callback)
+        {
+            std::lock_guard<std::mutex> lock(callback_mutex);
+            callback(result, *model);
+        }
+
+        // Give back the model.
+        if (is_reusable)
+        {
+            pool.release(std::move(model));
+        }
+    });
+}
+
+}
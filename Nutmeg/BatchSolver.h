@@ -0,0 +1,78 @@
+#ifndef NUTMEG_BATCHSOLVER_H
+#define NUTMEG_BATCHSOLVER_H
+
+#include "Includes.h"
+#include "Model.h"
+#include <functional>
+
+namespace Nutmeg
+{
+
+// Builds a model and returns its objective variable
+using ModelBuilder = std::function<IntVar(Model&)>;
+
+struct BatchJob
+{
+    String name;
+    ModelBuilder build;
+    Float time_limit;
+    Method method;
+    Float predicted_cost;
+};
+
+struct BatchResult
+{
+    Int job_idx;
+    String name;
+    Status status;
+    Float primal_bound;
+    Float dual_bound;
+    Float run_time;
+    Float predicted_cost;
+};
+
+// Solves many independent models in one process over a fixed pool of worker threads. Jobs are queued
+// longest-predicted-first by a cost estimated by the caller without building the model, so that large
+// jobs do not straggle at the end of the batch. Each worker builds a model just before solving it, in a
+// model taken from a pool and reset after the job, so SCIP and its plugins are set up once per worker
+// rather than once per job. Results are streamed to a callback as each job finishes; the callback is
+// never called concurrently. A job whose builder or solve throws is reported with status Error.
+// Separate models share no Nutmeg or SCIP state, but Geas has not been audited for global state, so
+// solving concurrently is only checked by the parallel_models test and is not guaranteed to be safe.
+class BatchSolver
+{
+    Vector<BatchJob> jobs_;
+    Int nb_threads_;
+
+  public:
+    // Constructors
+    // ------------
+    // Use as many threads as there are cores, limited by the available memory divided by the memory
+    // expected for each job (in bytes), unless the number of threads is given.
+    BatchSolver(const Int nb_threads = 0, const Float memory_per_job = 512.0 * 1024 * 1024);
+    BatchSolver(const BatchSolver& batch) = delete;
+    BatchSolver(BatchSolver&& batch) = delete;
+    BatchSolver& operator=(const BatchSolver& batch) = delete;
+    BatchSolver& operator=(BatchSolver&& batch) = delete;
+    ~BatchSolver() = default;
+
+    // Add jobs
+    // --------
+    // The predicted cost is any estimate of the run time that orders the jobs, such as the size of the
+    // instance. Jobs with equal predicted costs run in the order they are added.
+    void add_job(const String& name,
+                 ModelBuilder build,
+                 const Float time_limit = Infinity,
+                 const Method method = Method::BC,
+                 const Float predicted_cost = 0.0);
+    inline Int nb_jobs() const { return jobs_.size(); }
+    inline Int nb_threads() const { return nb_threads_; }
+
+    // Solve
+    // -----
+    void run(std::function<void(const BatchResult&, Model&)> callback);
+};
+
+}
+
+#endif
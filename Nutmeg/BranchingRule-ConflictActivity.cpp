@@ -0,0 +1,166 @@
+//#define PRINT_DEBUG
+
+#include "BranchingRule-ConflictActivity.h"
+#include <algorithm>
+
+#define BRANCHRULE_NAME                  "cpactivity"
+#define BRANCHRULE_DESC   "branching on the activity of variables in CP nogoods"
+#define BRANCHRULE_PRIORITY                     20000 // priority of the branching rule
+#define BRANCHRULE_MAXDEPTH                        -1 // maximal depth level of the branching rule
+#define BRANCHRULE_MAXBOUNDDIST                   1.0 // maximal relative distance from current node's dual bound to
+                                                      // primal bound compared to best node's dual bound for applying
+                                                      // branching
+
+namespace Nutmeg
+{
+
+// Variable in Nutmeg of a variable in the MIP
+struct ActivityVar
+{
+    Int idx;
+    bool is_int;
+};
+
+struct BranchruleConflictActivityData
+{
+    HashTable<SCIP_VAR*, ActivityVar> vars;
+};
+
+// Map the variables in the MIP to the variables in Nutmeg
+static
+void create_var_map(
+    ProblemData& probdata,                        // Problem data
+    BranchruleConflictActivityData& branchdata    // Branching rule data
+)
+{
+    branchdata.vars.clear();
+    for (Int idx = 2; idx < probdata.nb_bool_vars(); ++idx)
+        if (probdata.is_pos_var(idx))
+        {
+            branchdata.vars.emplace(probdata.mip_bool_vars_[idx], ActivityVar{idx, false});
+        }
+    for (Int idx = 1; idx < probdata.nb_int_vars(); ++idx)
+        if (auto mip_var = probdata.mip_int_vars_[idx]; mip_var)
+        {
+            branchdata.vars.emplace(mip_var, ActivityVar{idx, true});
+        }
+}
+
+// Branching execution method for fractional LP solutions. Branches on the fractional variable with the
+// highest activity in nogoods, breaking ties by fractionality, and leaves the decision to the other
+// branching rules if no candidate has appeared in a nogood.
+static
+SCIP_DECL_BRANCHEXECLP(branchExeclpConflictActivity)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(branchrule);
+    debug_assert(strcmp(SCIPbranchruleGetName(branchrule), BRANCHRULE_NAME) == 0);
+    debug_assert(result);
+    *result = SCIP_DIDNOTRUN;
+
+    // Get problem data.
+    auto& probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(scip));
+    auto& branchdata = *reinterpret_cast<BranchruleConflictActivityData*>(SCIPbranchruleGetData(branchrule));
+    if (branchdata.vars.empty())
+    {
+        create_var_map(probdata, branchdata);
+    }
+
+    // Get branching candidates.
+    SCIP_VAR** cands = nullptr;
+    SCIP_Real* cands_frac = nullptr;
+    int nb_cands = 0;
+    SCIP_CALL(SCIPgetLPBranchCands(scip, &cands, nullptr, &cands_frac, nullptr, &nb_cands, nullptr));
+
+    // Find the candidate with the highest activity.
+    SCIP_VAR* best_var = nullptr;
+    Float best_activity = 0.0;
+    Float best_frac = 0.0;
+    for (int k = 0; k < nb_cands; ++k)
+        if (auto it = branchdata.vars.find(cands[k]); it != branchdata.vars.end())
+        {
+            const auto [idx, is_int] = it->second;
+            const auto& activities = is_int ? probdata.int_vars_activity_ : probdata.bool_vars_activity_;
+            const auto activity = idx < static_cast<Int>(activities.size()) ? activities[idx] : 0.0;
+            const auto frac = std::min(cands_frac[k], 1.0 - cands_frac[k]);
+            if (activity > best_activity || (activity == best_activity && best_var && frac > best_frac))
+            {
+                best_var = cands[k];
+                best_activity = activity;
+                best_frac = frac;
+            }
+        }
+    if (!best_var)
+    {
+        return SCIP_OKAY;
+    }
+
+    // Branch.
+    debugln("Branching on {} with activity {}", SCIPvarGetName(best_var), best_activity);
+    SCIP_CALL(SCIPbranchVar(scip, best_var, nullptr, nullptr, nullptr));
+    *result = SCIP_BRANCHED;
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Solving process deinitialization method of branching rule (called before branch and bound process data
+// is freed)
+static
+SCIP_DECL_BRANCHEXITSOL(branchExitsolConflictActivity)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(branchrule);
+
+    // Clear the variables, which belong to the transformed problem.
+    auto& branchdata = *reinterpret_cast<BranchruleConflictActivityData*>(SCIPbranchruleGetData(branchrule));
+    branchdata.vars.clear();
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Destructor of branching rule
+static
+SCIP_DECL_BRANCHFREE(branchFreeConflictActivity)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(branchrule);
+
+    // Free branching rule data.
+    delete reinterpret_cast<BranchruleConflictActivityData*>(SCIPbranchruleGetData(branchrule));
+    SCIPbranchruleSetData(branchrule, nullptr);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Include branching rule preferring variables that often appear in nogoods from the CP solver
+SCIP_RETCODE includeBranchruleConflictActivity(SCIP* scip)
+{
+    // Create branching rule data.
+    auto branchdata = new BranchruleConflictActivityData;
+
+    // Create branching rule.
+    SCIP_BRANCHRULE* branchrule = nullptr;
+    SCIP_CALL(SCIPincludeBranchruleBasic(scip,
+                                         &branchrule,
+                                         BRANCHRULE_NAME,
+                                         BRANCHRULE_DESC,
+                                         BRANCHRULE_PRIORITY,
+                                         BRANCHRULE_MAXDEPTH,
+                                         BRANCHRULE_MAXBOUNDDIST,
+                                         reinterpret_cast<SCIP_BRANCHRULEDATA*>(branchdata)));
+    debug_assert(branchrule);
+    SCIP_CALL(SCIPsetBranchruleExecLp(scip, branchrule, branchExeclpConflictActivity));
+    SCIP_CALL(SCIPsetBranchruleExitsol(scip, branchrule, branchExitsolConflictActivity));
+    SCIP_CALL(SCIPsetBranchruleFree(scip, branchrule, branchFreeConflictActivity));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+}
@@ -0,0 +1,15 @@
+#ifndef NUTMEG_BRANCHINGRULE_CONFLICTACTIVITY_H
+#define NUTMEG_BRANCHINGRULE_CONFLICTACTIVITY_H
+
+#include "Includes.h"
+#include "ProblemData.h"
+
+namespace Nutmeg
+{
+
+// Include branching rule preferring variables that often appear in nogoods from the CP solver
+SCIP_RETCODE includeBranchruleConflictActivity(SCIP* scip);
+
+}
+
+#endif
@@ -6,11 +6,26 @@
 #include "scip/cons_linear.h"
 #include "scip/cons_logicor.h"
 #include "scip/cons_bounddisjunction.h"
+#include <algorithm>
+#include <climits>
 
 #define MAX_FRACTIONAL_CHECK_DURATION                  0.3
 #define MAX_FRACTIONAL_CHECK_CONFLICTS                 300
 #define MAX_CUT_MINIMIZATION_DURATION                  0.3
 #define MAX_CUT_MINIMIZATION_CONFLICTS                 300
+#define MAX_PROPAGATION_CONFLICT_DURATION              0.1
+#define MAX_EXTRA_NOGOODS                                4
+#define MAX_EXTRA_NOGOOD_DURATION                      0.1
+#define MAX_EXTRA_NOGOOD_CONFLICTS                     300
+#define MAX_SYMMETRIC_NOGOODS                           16
+#define MAX_OPTIMALITY_CUT_SEARCHES                      8
+#define MAX_OPTIMALITY_CUT_DURATION                    0.2
+#define MAX_OPTIMALITY_CUT_CONFLICTS                   300
+#define RESTART_NOGOODS                                250 // default number of nogoods and fixings in a run that trigger a restart
+#define RESTART_MAX_NODES                              100 // default number of nodes in a run after which it is not restarted
+#define MAX_RESTARTS                                     2 // default maximum number of restarts requested after finding nogoods
+#define MULTI_CUT                                    FALSE // default for adding extra nogoods over other variables after a nogood
+#define OPTIMALITY_CUTS                              FALSE // default for adding optimality cuts instead of nogoods on the objective
 
 #define CONSHDLR_NAME                               "geas"
 #define CONSHDLR_DESC                      "CP subproblem"
@@ -128,6 +143,80 @@ void print_sol(
 }
 #endif
 
+// Assume the value of a Boolean variable if it is integral
+static inline
+bool make_bool_var_assumption(
+    SCIP* scip,               // SCIP
+    SCIP_SOL* sol,            // Solution
+    ProblemData& probdata,    // Problem data
+    geas::solver& cp,         // CP solver
+    const Int idx             // Index of Boolean variable
+)
+{
+    const auto mip_var = probdata.mip_bool_vars_[idx];
+    debug_assert(mip_var);
+
+    const auto val = SCIPgetSolVal(scip, sol, mip_var);
+    if (SCIPisEQ(scip, val, 1.0))
+    {
+        debugln("      {} (bool var {})", probdata.bool_vars_name_[idx], idx);
+        const auto& cp_var = probdata.cp_bool_vars_[idx];
+        return cp.assume(cp_var);
+    }
+    else if (SCIPisZero(scip, val))
+    {
+        debugln("      ~{} (bool var {})", probdata.bool_vars_name_[idx], idx);
+        const auto& cp_var = probdata.cp_bool_vars_[idx];
+        return cp.assume(~cp_var);
+    }
+    return true;
+}
+
+// Assume the value of an integer variable in the MIP, or the two integers around it if it is fractional
+static inline
+bool make_int_var_assumptions(
+    SCIP* scip,               // SCIP
+    SCIP_SOL* sol,            // Solution
+    ProblemData& probdata,    // Problem data
+    geas::solver& cp,         // CP solver
+    const Int idx             // Index of integer variable
+)
+{
+    const auto mip_var = probdata.mip_int_vars_[idx];
+    debug_assert(mip_var);
+
+    const auto val = SCIPgetSolVal(scip, sol, mip_var);
+    Float val_up, val_down;
+    if (SCIPisIntegral(scip, val))
+    {
+        val_up = SCIPround(scip, val);
+        val_down = val_up;
+    }
+    else
+    {
+        val_up = std::ceil(val);
+        val_down = std::floor(val);
+    }
+    debug_assert(val_down <= val_up);
+
+    const auto& cp_var = probdata.cp_int_vars_[idx];
+    {
+        debugln("      [{} >= {}] (int var {})", probdata.int_vars_name_[idx], val_down, idx);
+        const auto success = cp.assume(cp_var >= val_down);
+        if (!success)
+            return false;
+    }
+    {
+        debugln("      [{} <= {}] (int var {})", probdata.int_vars_name_[idx], val_up, idx);
+        const auto success = cp.assume(cp_var <= val_up);
+        if (!success)
+            return false;
+    }
+
+    // Success.
+    return true;
+}
+
 bool make_bool_assumptions(
     SCIP* scip,               // SCIP
     SCIP_SOL* sol,            // Solution
@@ -141,28 +230,10 @@ bool make_bool_assumptions(
 
     // Make assumptions on Boolean variables.
     for (Int idx = 2; idx < probdata.nb_bool_vars(); ++idx)
-    {
-        const auto mip_var = probdata.mip_bool_vars_[idx];
-        debug_assert(mip_var);
-
-        const auto val = SCIPgetSolVal(scip, sol, mip_var);
-        if (SCIPisEQ(scip, val, 1.0))
-        {
-            debugln("      {} (bool var {})", probdata.bool_vars_name_[idx], idx);
-            const auto& cp_var = probdata.cp_bool_vars_[idx];
-            const auto success = cp.assume(cp_var);
-            if (!success)
-                return false;
-        }
-        else if (SCIPisZero(scip, val))
+        if (!make_bool_var_assumption(scip, sol, probdata, cp, idx))
         {
-            debugln("      ~{} (bool var {})", probdata.bool_vars_name_[idx], idx);
-            const auto& cp_var = probdata.cp_bool_vars_[idx];
-            const auto success = cp.assume(~cp_var);
-            if (!success)
-                return false;
+            return false;
         }
-    }
 
     // Success.
     return true;
@@ -181,39 +252,10 @@ bool make_int_assumptions(
 
     // Make assumptions on integer variables.
     for (Int idx = 1; idx < probdata.nb_int_vars(); ++idx)
-    {
-        const auto mip_var = probdata.mip_int_vars_[idx];
-        if (mip_var)
+        if (probdata.mip_int_vars_[idx] && !make_int_var_assumptions(scip, sol, probdata, cp, idx))
         {
-            const auto val = SCIPgetSolVal(scip, sol, mip_var);
-            Float val_up, val_down;
-            if (SCIPisIntegral(scip, val))
-            {
-                val_up = SCIPround(scip, val);
-                val_down = val_up;
-            }
-            else
-            {
-                val_up = std::ceil(val);
-                val_down = std::floor(val);
-            }
-            debug_assert(val_down <= val_up);
-
-            const auto& cp_var = probdata.cp_int_vars_[idx];
-            {
-                debugln("      [{} >= {}] (int var {})", probdata.int_vars_name_[idx], val_down, idx);
-                const auto success = cp.assume(cp_var >= val_down);
-                if (!success)
-                    return false;
-            }
-            {
-                debugln("      [{} <= {}] (int var {})", probdata.int_vars_name_[idx], val_up, idx);
-                const auto success = cp.assume(cp_var <= val_up);
-                if (!success)
-                    return false;
-            }
+            return false;
         }
-    }
 
     // Success.
     return true;
@@ -227,50 +269,45 @@ bool make_obj_assumptions(
 )
 {
     // Make assumptions on objective variable.
-    const auto idx = probdata.obj_var_idx_;
-    {
-        const auto mip_var = probdata.mip_int_vars_[idx];
-        debug_assert(mip_var);
-        {
-            const auto val = SCIPgetSolVal(scip, sol, mip_var);
-            Float val_up, val_down;
-            if (SCIPisIntegral(scip, val))
-            {
-                val_up = SCIPround(scip, val);
-                val_down = val_up;
-            }
-            else
-            {
-                val_up = std::ceil(val);
-                val_down = std::floor(val);
-            }
-            debug_assert(val_down <= val_up);
+    return make_int_var_assumptions(scip, sol, probdata, cp, probdata.obj_var_idx_);
+}
 
-            const auto& cp_var = probdata.cp_int_vars_[idx];
-            {
-                debugln("      [{} >= {}] (int var {})", probdata.int_vars_name_[idx], val_down, idx);
-                const auto success = cp.assume(cp_var >= val_down);
-                if (!success)
-                    return false;
-            }
+// Make assumptions on the Boolean variables of one component of the CP subproblem, and also on its
+// integer variables in the MIP if requested
+static
+bool make_component_assumptions(
+    SCIP* scip,                       // SCIP
+    SCIP_SOL* sol,                    // Solution
+    ProblemData& probdata,            // Problem data
+    geas::solver& cp,                 // CP solver
+    const CpComponent& component,     // Component
+    const bool with_int_vars          // Also assume the integer variables?
+)
+{
+    for (const auto idx : component.bool_vars_idx)
+        if (!make_bool_var_assumption(scip, sol, probdata, cp, idx))
+        {
+            return false;
+        }
+    if (with_int_vars)
+        for (const auto idx : component.mip_int_vars_idx)
+            if (!make_int_var_assumptions(scip, sol, probdata, cp, idx))
             {
-                debugln("      [{} <= {}] (int var {})", probdata.int_vars_name_[idx], val_up, idx);
-                const auto success = cp.assume(cp_var <= val_up);
-                if (!success)
-                    return false;
+                return false;
             }
-        }
-    }
 
     // Success.
     return true;
 }
 
+// Assume the bounds of the MIP variables at the time of a bound change, or the local bounds if the bound
+// change index is null
 static
 bool make_bounds_assumptions(
-    SCIP* scip,               // SCIP
-    ProblemData& probdata,    // Problem data
-    geas::solver& cp          // CP solver
+    SCIP* scip,                 // SCIP
+    ProblemData& probdata,      // Problem data
+    geas::solver& cp,           // CP solver
+    SCIP_BDCHGIDX* bdchgidx     // Bound change index
 )
 {
     // Make assumptions on Boolean variables.
@@ -279,8 +316,8 @@ bool make_bounds_assumptions(
         const auto mip_var = probdata.mip_bool_vars_[idx];
         debug_assert(mip_var);
 
-        const auto lb = SCIPround(scip, SCIPvarGetLbLocal(mip_var));
-        const auto ub = SCIPround(scip, SCIPvarGetUbLocal(mip_var));
+        const auto lb = SCIPround(scip, SCIPgetVarLbAtIndex(scip, mip_var, bdchgidx, FALSE));
+        const auto ub = SCIPround(scip, SCIPgetVarUbAtIndex(scip, mip_var, bdchgidx, FALSE));
         debug_assert(lb <= ub);
 
         if (SCIPisEQ(scip, lb, 1.0))
@@ -307,8 +344,8 @@ bool make_bounds_assumptions(
         const auto mip_var = probdata.mip_int_vars_[idx];
         if (mip_var)
         {
-            const auto lb = SCIPround(scip, SCIPvarGetLbLocal(mip_var));
-            const auto ub = SCIPround(scip, SCIPvarGetUbLocal(mip_var));
+            const auto lb = SCIPround(scip, SCIPgetVarLbAtIndex(scip, mip_var, bdchgidx, FALSE));
+            const auto ub = SCIPround(scip, SCIPgetVarUbAtIndex(scip, mip_var, bdchgidx, FALSE));
             debug_assert(lb <= ub);
 
             const auto& cp_var = probdata.cp_int_vars_[idx];
@@ -361,6 +398,18 @@ NogoodData get_nogood(
 #endif
 
     // Get the literals of the nogood.
+    add_nogood_literals(conflict, probdata, nogood);
+
+    // Done.
+    return nogood;
+}
+
+void add_nogood_literals(
+    vec<geas::patom_t>& conflict,    // Nogood in CP
+    ProblemData& probdata,           // Problem data
+    NogoodData& nogood               // Nogood in MIP
+)
+{
     for (const auto atom : conflict)
     {
         // Add literals from binary variables.
@@ -373,7 +422,6 @@ NogoodData get_nogood(
                 nogood.vars.push_back(mip_var);
                 nogood.signs.push_back(SCIP_BOUNDTYPE_LOWER);
                 nogood.bounds.push_back(1);
-
                 goto NEXT_LITERAL;
             }
             else if (atom == ~cp_var)
@@ -382,7 +430,6 @@ NogoodData get_nogood(
                 nogood.vars.push_back(mip_var);
                 nogood.signs.push_back(SCIP_BOUNDTYPE_UPPER);
                 nogood.bounds.push_back(0);
-
                 goto NEXT_LITERAL;
             }
         }
@@ -460,9 +507,6 @@ NogoodData get_nogood(
         // Next iteration.
         NEXT_LITERAL:;
     }
-
-    // Done.
-    return nogood;
 }
 
 static inline
@@ -478,21 +522,154 @@ Float get_time_remaining(
 }
 
 static
-void store_cp_solution(
+void get_cp_solution(
     ProblemData& probdata,    // Problem data
-    geas::solver& cp          // CP solver
+    geas::solver& cp,         // CP solver
+    Solution& sol             // Output solution
 )
 {
+    sol.bool_vars_sol_.resize(probdata.nb_bool_vars());
+    sol.int_vars_sol_.resize(probdata.nb_int_vars());
     for (Int idx = 0; idx < probdata.nb_bool_vars(); ++idx)
     {
         const auto& cp_var = probdata.cp_bool_vars_[idx];
-        probdata.sol_.bool_vars_sol_[idx] = cp_var.lb(cp.data->state.p_vals);
+        sol.bool_vars_sol_[idx] = cp_var.lb(cp.data->state.p_vals);
     }
     for (Int idx = 0; idx < probdata.nb_int_vars(); ++idx)
     {
         const auto& cp_var = probdata.cp_int_vars_[idx];
-        probdata.sol_.int_vars_sol_[idx] = cp_var.lb(cp.data);
+        sol.int_vars_sol_[idx] = cp_var.lb(cp.data);
+    }
+}
+
+static
+void store_cp_solution(
+    ProblemData& probdata,    // Problem data
+    geas::solver& cp          // CP solver
+)
+{
+    get_cp_solution(probdata, cp, probdata.sol_);
+}
+
+// Fix a variable to a value in the LP of a dive
+static
+SCIP_RETCODE fix_var_dive(
+    SCIP* scip,          // SCIP
+    SCIP_VAR* var,       // Variable
+    const Float val      // Value
+)
+{
+    if (SCIPisGT(scip, val, SCIPgetVarUbDive(scip, var)))
+    {
+        SCIP_CALL(SCIPchgVarUbDive(scip, var, val));
+        SCIP_CALL(SCIPchgVarLbDive(scip, var, val));
+    }
+    else
+    {
+        SCIP_CALL(SCIPchgVarLbDive(scip, var, val));
+        SCIP_CALL(SCIPchgVarUbDive(scip, var, val));
+    }
+    return SCIP_OKAY;
+}
+
+// Set the auxiliary variables of the MIP relaxation in a solution by fixing the variables of the model
+// to their values in the LP of a dive and copying the LP solution. The LP of the dive can leave the
+// bounds of the current node, which the solution of the CP solver need not satisfy.
+static
+SCIP_RETCODE complete_cp_solution(
+    SCIP* scip,                // SCIP
+    ProblemData& probdata,     // Problem data
+    const Solution& cp_sol,    // Solution of the CP solver
+    SCIP_SOL* sol,             // Solution setting the variables of the model
+    bool& is_completed         // Output whether the auxiliary variables are set
+)
+{
+    // Check if the LP can be used.
+    is_completed = false;
+    if (SCIPgetStage(scip) != SCIP_STAGE_SOLVING ||
+        SCIPinProbing(scip) ||
+        SCIPinDive(scip) ||
+        !SCIPhasCurrentNodeLP(scip) ||
+        SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL)
+    {
+        return SCIP_OKAY;
+    }
+
+    // Fix the variables of the model.
+    SCIP_CALL(SCIPstartDive(scip));
+    for (Int idx = 0; idx < probdata.nb_bool_vars(); ++idx)
+        if (auto mip_var = probdata.mip_bool_vars_[idx]; mip_var && probdata.is_pos_var(idx))
+        {
+            SCIP_CALL(fix_var_dive(scip, mip_var, cp_sol.bool_vars_sol_[idx]));
+        }
+    for (Int idx = 0; idx < probdata.nb_int_vars(); ++idx)
+        if (auto mip_var = probdata.mip_int_vars_[idx]; mip_var && !SCIPvarIsNegated(mip_var))
+        {
+            SCIP_CALL(fix_var_dive(scip, mip_var, cp_sol.int_vars_sol_[idx]));
+        }
+
+    // Solve the LP and copy its solution.
+    SCIP_Bool lperror = FALSE;
+    SCIP_Bool cutoff = FALSE;
+    SCIP_CALL(SCIPsolveDiveLP(scip, -1, &lperror, &cutoff));
+    if (!lperror && !cutoff && SCIPgetLPSolstat(scip) == SCIP_LPSOLSTAT_OPTIMAL)
+    {
+        SCIP_CALL(SCIPlinkLPSol(scip, sol));
+        SCIP_CALL(SCIPunlinkSol(scip, sol));
+        is_completed = true;
+    }
+    SCIP_CALL(SCIPendDive(scip));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Store the solution of the CP solver and add it to the MIP
+SCIP_RETCODE add_cp_solution(
+    SCIP* scip,               // SCIP
+    SCIP_HEUR* heur,          // Primal heuristic
+    ProblemData& probdata     // Problem data
+)
+{
+    // Get CP solution.
+    Solution cp_sol;
+    get_cp_solution(probdata, probdata.cp_, cp_sol);
+
+    // Create solution in MIP and set the auxiliary variables of the MIP relaxation.
+    SCIP_SOL* sol = nullptr;
+    SCIP_CALL(SCIPcreateSol(scip, &sol, heur));
+    bool is_completed = false;
+    SCIP_CALL(complete_cp_solution(scip, probdata, cp_sol, sol, is_completed));
+
+    // Set the variables of the model exactly.
+    for (Int idx = 0; idx < probdata.nb_bool_vars(); ++idx)
+        if (auto mip_var = probdata.mip_bool_vars_[idx]; mip_var && probdata.is_pos_var(idx))
+        {
+            SCIP_CALL(SCIPsetSolVal(scip, sol, mip_var, cp_sol.bool_vars_sol_[idx]));
+        }
+    for (Int idx = 0; idx < probdata.nb_int_vars(); ++idx)
+        if (auto mip_var = probdata.mip_int_vars_[idx]; mip_var)
+        {
+            SCIP_CALL(SCIPsetSolVal(scip, sol, mip_var, cp_sol.int_vars_sol_[idx]));
+        }
+
+    // Add solution if it satisfies the MIP. Without the LP, the solution is only accepted if the MIP has
+    // no auxiliary variables that it violates.
+    SCIP_Bool stored = FALSE;
+    SCIP_CALL(SCIPtrySolFree(scip, &sol, FALSE, TRUE, TRUE, TRUE, TRUE, &stored));
+    const auto obj_var_idx = probdata.obj_var_idx_;
+    debugln("   Added solution with obj {} (completed {}, stored {})",
+            cp_sol.int_vars_sol_[obj_var_idx], is_completed, stored);
+
+    // Store the solution of the model only if SCIP accepted it, so that the solution of the model stays
+    // the incumbent of SCIP.
+    if (stored && cp_sol.int_vars_sol_[obj_var_idx] < probdata.sol_.int_vars_sol_[obj_var_idx])
+    {
+        probdata.sol_ = std::move(cp_sol);
     }
+
+    // Done.
+    return SCIP_OKAY;
 }
 
 #ifdef CHECK_AT_LP
@@ -614,6 +791,106 @@ void store_solution(
     }
 }
 
+// Check an integral solution on every component of the CP subproblem in turn. Stops at the first
+// component that is infeasible or times out, leaving the conflict of an infeasible component, which
+// only involves variables in that component, in the CP solver. Components are checked first with
+// assumptions only on their Boolean variables if requested, so that conflicts are over Boolean variables
+// when possible.
+static
+geas::solver::result check_components(
+    SCIP* scip,                // SCIP
+    SCIP_SOL* sol,             // Integral solution
+    ProblemData& probdata,     // Problem data
+    geas::solver& cp,          // CP solver
+    const bool bool_vars_first // Check with assumptions on Boolean variables first?
+)
+{
+    // Check.
+    debug_assert(probdata.cp_components_.size() >= 2);
+    debug_assert(!sol_is_fractional(scip, sol, probdata));
+
+    // Take the values of variables in the MIP from the solution and the values of integer variables only
+    // in CP from the component containing them.
+    Solution component_sol;
+    component_sol.bool_vars_sol_.resize(probdata.nb_bool_vars());
+    component_sol.int_vars_sol_ = probdata.int_vars_lb_;
+    for (Int idx = 0; idx < probdata.nb_bool_vars(); ++idx)
+    {
+        const auto val = SCIPgetSolVal(scip, sol, probdata.mip_bool_vars_[idx]);
+        component_sol.bool_vars_sol_[idx] = SCIPisEQ(scip, val, 1.0);
+    }
+    for (Int idx = 0; idx < probdata.nb_int_vars(); ++idx)
+        if (const auto mip_var = probdata.mip_int_vars_[idx]; mip_var)
+        {
+            component_sol.int_vars_sol_[idx] = SCIPround(scip, SCIPgetSolVal(scip, sol, mip_var));
+        }
+        else
+        {
+            const auto& ind_vars_idx = probdata.mip_indicator_vars_idx_[idx];
+            for (Int k = 0; k < static_cast<Int>(ind_vars_idx.size()); ++k)
+                if (ind_vars_idx[k] >= 2 && component_sol.bool_vars_sol_[ind_vars_idx[k]])
+                {
+                    component_sol.int_vars_sol_[idx] = probdata.int_vars_lb_[idx] + k;
+                }
+        }
+
+    // Check every component. Stop at the first component that is infeasible or times out.
+    for (const auto& component : probdata.cp_components_)
+    {
+        for (const auto with_int_vars : {false, true})
+        {
+            // Skip the check only on Boolean variables.
+            if (!with_int_vars && (!bool_vars_first || component.mip_int_vars_idx.empty()))
+            {
+                continue;
+            }
+
+            // Make assumptions.
+            debugln("   Assumptions on component:");
+            cp.clear_assumptions();
+            if (!make_component_assumptions(scip, sol, probdata, cp, component, with_int_vars))
+            {
+                debugln("   Assumptions infeasible");
+                return geas::solver::UNSAT;
+            }
+            debugln("   Assumptions completed");
+
+            // Get time remaining.
+            const auto time_remaining = get_time_remaining(scip);
+            if (time_remaining <= 0)
+            {
+                debugln("   Timed out");
+                return geas::solver::UNKNOWN;
+            }
+
+            // Solve.
+            const auto cp_result = cp.solve(limits{.time = time_remaining, .conflicts = 0});
+            if (cp_result != geas::solver::SAT)
+            {
+                return cp_result;
+            }
+
+            // Get the values of the integer variables only in CP.
+            if (with_int_vars)
+                for (const auto idx : component.cp_int_vars_idx)
+                {
+                    component_sol.int_vars_sol_[idx] = probdata.cp_int_vars_[idx].lb(cp.data);
+                }
+        }
+    }
+
+    // Store the solution if it is better than the incumbent.
+    const auto obj_var_idx = probdata.obj_var_idx_;
+    if (component_sol.int_vars_sol_[obj_var_idx] < probdata.sol_.int_vars_sol_[obj_var_idx])
+    {
+        probdata.sol_.bool_vars_sol_ = std::move(component_sol.bool_vars_sol_);
+        probdata.sol_.int_vars_sol_ = std::move(component_sol.int_vars_sol_);
+    }
+
+    // Feasible.
+    return geas::solver::SAT;
+}
+
 #ifndef NDEBUG
 String make_atom_name(
     ProblemData& probdata,    // Problem data
@@ -885,6 +1162,15 @@ SCIP_RETCODE geas_check(
         }
     }
 
+    // Check the components of the CP subproblem separately.
+    if (probdata.cp_components_.size() >= 2 && !sol_is_fractional(scip, sol, probdata))
+    {
+        cp_result = check_components(scip, sol, probdata, cp, false);
+        debugln("   {}", cp_result == geas::solver::SAT ? "Feasible" : "Infeasible or timed out");
+        *result = cp_result == geas::solver::SAT ? SCIP_FEASIBLE : SCIP_INFEASIBLE;
+        return SCIP_OKAY;
+    }
+
     // Make assumptions.
     debugln("   Assumptions:");
     cp.clear_assumptions();
@@ -939,29 +1225,672 @@ SCIP_RETCODE geas_check(
     return SCIP_OKAY;
 }
 
+// Get the variable in a column of a symmetry group at the position of a variable in another column
 static
-SCIP_RETCODE geas_separate(
-    SCIP* scip,                       // SCIP
-    Nutmeg::ProblemData& probdata,    // Problem data
-    SCIP_RESULT* result               // Pointer to store the result
+SCIP_VAR* get_symmetric_var(
+    SCIP* scip,                              // SCIP
+    Nutmeg::ProblemData& probdata,           // Problem data
+    const Nutmeg::SymmetryPosition& pos,     // Position of the variable
+    const Int col                            // Column of the image
 )
 {
     using namespace Nutmeg;
 
-    constexpr SCIP_SOL* sol = nullptr;
+    const auto& group = probdata.symmetry_groups_[pos.group];
+    if (pos.is_int)
+    {
+        return probdata.mip_int_vars_[group.int_vars_idx[col][pos.row]];
+    }
+    auto var = probdata.mip_bool_vars_[group.bool_vars_idx[col][pos.row]];
+    if (var && pos.is_neg)
+    {
+        scip_assert(SCIPgetNegatedVar(scip, var, &var));
+    }
+    return var;
+}
 
-    // Print.
-    debugln("Starting Geas MIP separator on solution with obj {:.6f} (LP {:.6f}) at node "
-            "{}, depth {}:",
-            SCIPgetSolOrigObj(scip, sol),
-            SCIPgetLPObjval(scip),
-            SCIPnodeGetNumber(SCIPgetCurrentNode(scip)),
-            SCIPgetDepth(scip));
+// Add the images of a nogood under swapping a column of a symmetry group that contains a variable of the
+// nogood with another column. The images are implied by the CP subproblem, so they are valid cuts even if
+// they do not cut off the current solution.
+static
+SCIP_RETCODE add_symmetric_nogoods(
+    SCIP* scip,                             // SCIP
+    Nutmeg::ProblemData& probdata,          // Problem data
+    const Nutmeg::NogoodData& nogood        // Nogood
+)
+{
+    using namespace Nutmeg;
 
-    // Get problem.
-    auto& cp = probdata.cp_;
+    // Find the positions of the variables in the symmetry groups.
+    auto& positions = probdata.symmetry_positions_;
+    if (positions.empty())
+    {
+        for (Int group_idx = 0; group_idx < static_cast<Int>(probdata.symmetry_groups_.size()); ++group_idx)
+        {
+            const auto& group = probdata.symmetry_groups_[group_idx];
+            for (Int col = 0; col < static_cast<Int>(group.bool_vars_idx.size()); ++col)
+                for (Int row = 0; row < static_cast<Int>(group.bool_vars_idx[col].size()); ++row)
+                    if (auto var = probdata.mip_bool_vars_[group.bool_vars_idx[col][row]]; var)
+                    {
+                        positions.emplace(var, SymmetryPosition{group_idx, col, row, false, false});
+                        SCIP_VAR* neg_var = nullptr;
+                        SCIP_CALL(SCIPgetNegatedVar(scip, var, &neg_var));
+                        positions.emplace(neg_var, SymmetryPosition{group_idx, col, row, false, true});
+                    }
+            for (Int col = 0; col < static_cast<Int>(group.int_vars_idx.size()); ++col)
+                for (Int row = 0; row < static_cast<Int>(group.int_vars_idx[col].size()); ++row)
+                    if (auto var = probdata.mip_int_vars_[group.int_vars_idx[col][row]]; var)
+                    {
+                        positions.emplace(var, SymmetryPosition{group_idx, col, row, true, false});
+                    }
+        }
+    }
+
+    // Find the columns containing the variables of the nogood.
+    Vector<Pair<Int, Int>> cols;
+    for (const auto var : nogood.vars)
+        if (auto it = positions.find(var); it != positions.end())
+        {
+            const Pair<Int, Int> col{it->second.group, it->second.col};
+            if (std::find(cols.begin(), cols.end(), col) == cols.end())
+            {
+                cols.push_back(col);
+            }
+        }
+
+    // Swap each of these columns with every other column of its group.
+    Int nb_copies = 0;
+    for (const auto [group_idx, col] : cols)
+    {
+        const auto& group = probdata.symmetry_groups_[group_idx];
+        const Int nb_cols = std::max(group.bool_vars_idx.size(), group.int_vars_idx.size());
+        for (Int other_col = 0; other_col < nb_cols && nb_copies < MAX_SYMMETRIC_NOGOODS; ++other_col)
+        {
+            // Skip swaps already made from the other column.
+            const Pair<Int, Int> other{group_idx, other_col};
+            if (other_col == col ||
+                (other_col < col && std::find(cols.begin(), cols.end(), other) != cols.end()))
+            {
+                continue;
+            }
+
+            // Map the variables.
+            NogoodData copy;
+            copy.signs = nogood.signs;
+            copy.bounds = nogood.bounds;
+            copy.all_binary = nogood.all_binary;
+            bool is_valid = true;
+            for (const auto var : nogood.vars)
+            {
+                auto image = var;
+                if (auto it = positions.find(var); it != positions.end() && it->second.group == group_idx)
+                {
+                    const auto& pos = it->second;
+                    if (pos.col == col || pos.col == other_col)
+                    {
+                        image = get_symmetric_var(scip, probdata, pos, pos.col == col ? other_col : col);
+                    }
+                }
+                is_valid = is_valid && image;
+                copy.vars.push_back(image);
+            }
+            if (!is_valid)
+            {
+                continue;
+            }
+
+            // Add the copy.
+            NogoodPoolResult pool_result;
+            SCIP_CONS* cons = nullptr;
+            SCIP_CALL(probdata.nogood_pool_.add(scip, copy, pool_result, cons));
+            if (pool_result == NogoodPoolResult::Subsumed)
+            {
+                continue;
+            }
+            ++nb_copies;
+        }
+    }
+    debugln("   Adding {} symmetric copies of nogood", nb_copies);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Count a nogood and restart the solve once enough nogoods are found early in a run. Presolving and
+// separation at the root are then repeated with the nogoods, which stay in the transformed problem along
+// with the incumbent and the state of the CP solver.
+static
+SCIP_RETCODE restart_after_nogoods(
+    SCIP* scip,                       // SCIP
+    Nutmeg::ProblemData& probdata     // Problem data
+)
+{
+    // Count the nogood.
+    ++probdata.nb_run_nogoods_;
+
+    // Get parameters.
+    int restart_nogoods = 0;
+    int restart_max_nodes = 0;
+    int max_restarts = 0;
+    SCIP_CALL(SCIPgetIntParam(scip, "constraints/" CONSHDLR_NAME "/restartnogoods", &restart_nogoods));
+    SCIP_CALL(SCIPgetIntParam(scip, "constraints/" CONSHDLR_NAME "/restartmaxnodes", &restart_max_nodes));
+    SCIP_CALL(SCIPgetIntParam(scip, "constraints/" CONSHDLR_NAME "/maxrestarts", &max_restarts));
+
+    // Restart.
+    if (SCIPgetStage(scip) == SCIP_STAGE_SOLVING &&
+        restart_nogoods > 0 &&
+        probdata.nb_run_nogoods_ >= restart_nogoods &&
+        SCIPgetNNodes(scip) <= restart_max_nodes &&
+        (max_restarts == -1 || SCIPgetNRuns(scip) <= max_restarts))
+    {
+        debugln("   Restarting run {} after {} nogoods at node {}",
+                SCIPgetNRuns(scip), probdata.nb_run_nogoods_, SCIPgetNNodes(scip));
+        SCIP_CALL(SCIPrestartSolve(scip));
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Bump the activity of the variables in a nogood added to the MIP and decay the activity of the others
+static
+void bump_nogood_activities(
+    Nutmeg::ProblemData& probdata,     // Problem data
+    const Nutmeg::NogoodData& nogood   // Nogood
+)
+{
+    // Bump the activity of variables in the nogood. Literals of integer variables without a MIP variable
+    // are over their indicator variables.
+    const auto& mip_bool_vars = probdata.mip_bool_vars_;
+    const auto& mip_int_vars = probdata.mip_int_vars_;
+    for (const auto var : nogood.vars)
+    {
+        if (auto bool_it = std::find(mip_bool_vars.begin(), mip_bool_vars.end(), var); bool_it != mip_bool_vars.end())
+        {
+            probdata.bump_bool_var_activity(bool_it - mip_bool_vars.begin());
+        }
+        else if (auto int_it = std::find(mip_int_vars.begin(), mip_int_vars.end(), var); int_it != mip_int_vars.end())
+        {
+            probdata.bump_int_var_activity(int_it - mip_int_vars.begin());
+        }
+    }
+
+    // Decay the activity of variables not in the nogood.
+    probdata.decay_activities();
+}
+
+// Add a nogood from Geas to the MIP. A nogood with no literals proves infeasibility, a nogood with one
+// literal is a global bound change and longer nogoods are added as global constraints. Nogoods found
+// while propagating must only return results valid for a propagator.
+static
+SCIP_RETCODE add_nogood(
+    SCIP* scip,                       // SCIP
+    Nutmeg::ProblemData& probdata,    // Problem data
+    Nutmeg::NogoodData& nogood,       // Nogood
+    const bool is_propagating,        // Called from the propagator?
+    SCIP_RESULT* result               // Pointer to store the result
+)
+{
+    using namespace Nutmeg;
+
+    // If there is zero literals, the problem is infeasible.
+    if (nogood.vars.size() == 0)
+    {
+        scip_assert(SCIPinterruptSolve(scip));
+        *result = SCIP_CUTOFF;
+        return SCIP_OKAY;
+    }
+
+    // Restart if enough nogoods are found.
+    SCIP_CALL(restart_after_nogoods(scip, probdata));
+
+    // Add the copies of the nogood under the symmetries.
+    if (!probdata.symmetry_groups_.empty())
+    {
+        SCIP_CALL(add_symmetric_nogoods(scip, probdata, nogood));
+    }
+
+    // If there is one literal, enforce the bound change globally.
+    if (nogood.vars.size() == 1)
+    {
+        // Keep the nogood for solving again after the model is changed. Longer nogoods are kept in the
+        // pool.
+        probdata.nogoods_.push_back(nogood);
+
+        // Change bound. The bound can exclude the local domain if the nogood comes from a failed
+        // propagation.
+        auto var = nogood.vars[0];
+        const auto sign = nogood.signs[0];
+        const auto bound = nogood.bounds[0];
+        SCIP_Bool infeasible = FALSE;
+        SCIP_Bool tightened = FALSE;
+        if (sign == SCIP_BOUNDTYPE_UPPER)
+        {
+            debug_assert(SCIPisLT(scip, bound, SCIPvarGetUbLocal(var)));
+            scip_assert(SCIPtightenVarUbGlobal(scip, var, bound, FALSE, &infeasible, &tightened));
+        }
+        else
+        {
+            debug_assert(SCIPisGT(scip, bound, SCIPvarGetLbLocal(var)));
+            if (var == probdata.mip_int_vars_[probdata.obj_var_idx_])
+            {
+                if (SCIPisGT(scip, bound, SCIPvarGetUbLocal(var)))
+                {
+                    probdata.cp_dual_bound_ = std::max<Int>(probdata.cp_dual_bound_, bound);
+                    *result = SCIP_CUTOFF;
+                    return SCIP_OKAY;
+                }
+                else
+                {
+                    scip_assert(SCIPtightenVarLbGlobal(scip, var, bound, FALSE, &infeasible, &tightened));
+                }
+            }
+            else
+            {
+                scip_assert(SCIPtightenVarLbGlobal(scip, var, bound, FALSE, &infeasible, &tightened));
+            }
+        }
+
+        // Update activities.
+        bump_nogood_activities(probdata, nogood);
+
+        // Reduced domain.
+        *result = infeasible ? SCIP_CUTOFF : SCIP_REDUCEDDOM;
+        return SCIP_OKAY;
+    }
+
+    // Add constraint unless a nogood in the pool subsumes the nogood.
+    NogoodPoolResult pool_result;
+    SCIP_CONS* cons = nullptr;
+    SCIP_CALL(probdata.nogood_pool_.add(scip, nogood, pool_result, cons));
+    if (pool_result == NogoodPoolResult::Subsumed)
+    {
+        // Cut off the node if every bound of the nogood is excluded by the local domains. The subsuming
+        // nogood is then violated at every solution in the node.
+        bool is_violated = true;
+        for (size_t idx = 0; idx < nogood.vars.size() && is_violated; ++idx)
+        {
+            const auto var = nogood.vars[idx];
+            is_violated = nogood.signs[idx] == SCIP_BOUNDTYPE_LOWER ?
+                          SCIPisLT(scip, SCIPvarGetUbLocal(var), nogood.bounds[idx]) :
+                          SCIPisGT(scip, SCIPvarGetLbLocal(var), nogood.bounds[idx]);
+        }
+        if (is_violated)
+        {
+            debugln("   Nogood is subsumed by an active nogood violated in the node");
+            *result = SCIP_CUTOFF;
+            return SCIP_OKAY;
+        }
+
+        // Otherwise enforce the subsuming constraint on the LP solution, which violates it too. The
+        // propagator cannot enforce, and the subsuming constraint propagates by itself.
+        if (is_propagating)
+        {
+            *result = SCIP_DIDNOTFIND;
+            return SCIP_OKAY;
+        }
+        debugln("   Enforcing active nogood subsuming the nogood");
+        SCIP_CALL(SCIPenfolpCons(scip, cons, FALSE, result));
+        return SCIP_OKAY;
+    }
+
+    // Update activities of the created or reactivated constraint.
+    bump_nogood_activities(probdata, nogood);
+
+    // Return.
+    if (nogood.all_binary)
+    {
+        // Created constraint.
+        debugln("   Adding nogood with only binary variables");
+        *result = SCIP_CONSADDED;
+        return SCIP_OKAY;
+    }
+    else
+    {
+        // Created constraint.
+        debugln("   Adding nogood with integer variables");
+        *result = SCIP_INFEASIBLE; // Stuck in infinite loop if returning CONSADDED
+        return SCIP_OKAY;
+    }
+}
+
+// Assumptions made in the stages of the separator
+enum class AssumptionStage
+{
+    BoolVars,
+    BoolAndObjVars,
+    AllVars
+};
+
+// Make the assumptions of a stage of the separator except on blocked MIP variables
+static
+bool make_unblocked_assumptions(
+    SCIP* scip,                                // SCIP
+    SCIP_SOL* sol,                             // Solution
+    ProblemData& probdata,                     // Problem data
+    geas::solver& cp,                          // CP solver
+    const AssumptionStage stage,               // Stage of the separator
+    const Vector<SCIP_VAR*>& blocked_vars      // Sorted list of blocked MIP variables
+)
+{
+    const auto is_blocked = [&](SCIP_VAR* mip_var)
+    {
+        return std::binary_search(blocked_vars.begin(), blocked_vars.end(), mip_var);
+    };
+
+    // Block the indicator variables of blocked integer variables.
+    Vector<bool> bool_var_is_blocked(probdata.nb_bool_vars());
+    for (Int idx = 2; idx < probdata.nb_bool_vars(); ++idx)
+    {
+        bool_var_is_blocked[idx] = is_blocked(probdata.mip_bool_vars_[idx]);
+    }
+    for (Int idx = 1; idx < probdata.nb_int_vars(); ++idx)
+        if (const auto mip_var = probdata.mip_int_vars_[idx]; mip_var && is_blocked(mip_var))
+            for (const auto ind_var_idx : probdata.mip_indicator_vars_idx_[idx])
+            {
+                bool_var_is_blocked[ind_var_idx] = true;
+            }
+
+    // Make assumptions on Boolean variables.
+    for (Int idx = 2; idx < probdata.nb_bool_vars(); ++idx)
+        if (!bool_var_is_blocked[idx] && !make_bool_var_assumption(scip, sol, probdata, cp, idx))
+        {
+            return false;
+        }
+
+    // Make assumptions on integer variables.
+    if (stage == AssumptionStage::BoolAndObjVars)
+    {
+        const auto idx = probdata.obj_var_idx_;
+        if (!is_blocked(probdata.mip_int_vars_[idx]) && !make_int_var_assumptions(scip, sol, probdata, cp, idx))
+        {
+            return false;
+        }
+    }
+    else if (stage == AssumptionStage::AllVars)
+    {
+        for (Int idx = 1; idx < probdata.nb_int_vars(); ++idx)
+            if (const auto mip_var = probdata.mip_int_vars_[idx];
+                mip_var && !is_blocked(mip_var) && !make_int_var_assumptions(scip, sol, probdata, cp, idx))
+            {
+                return false;
+            }
+    }
+
+    // Success.
+    return true;
+}
+
+// Block the variables of a nogood, including their negations
+static
+void block_nogood_vars(
+    const NogoodData& nogood,          // Nogood
+    Vector<SCIP_VAR*>& blocked_vars    // Sorted list of blocked MIP variables
+)
+{
+    for (auto mip_var : nogood.vars)
+    {
+        blocked_vars.push_back(mip_var);
+        if (auto neg_var = SCIPvarGetNegationVar(mip_var); neg_var)
+        {
+            blocked_vars.push_back(neg_var);
+        }
+    }
+    std::sort(blocked_vars.begin(), blocked_vars.end());
+    blocked_vars.erase(std::unique(blocked_vars.begin(), blocked_vars.end()), blocked_vars.end());
+}
+
+// Combine the results of adding two nogoods, keeping the stronger one
+static inline
+SCIP_RESULT combine_nogood_results(const SCIP_RESULT a, const SCIP_RESULT b)
+{
+    for (const auto r : {SCIP_CUTOFF, SCIP_CONSADDED, SCIP_REDUCEDDOM})
+        if (a == r || b == r)
+        {
+            return r;
+        }
+    return a;
+}
+
+// Find and add more nogoods violated by the solution. The variables of the nogoods found so far are
+// dropped from the assumptions and the CP subproblem is solved again for a conflict over other variables,
+// up to a budget of nogoods.
+static
+SCIP_RETCODE add_extra_nogoods(
+    SCIP* scip,                        // SCIP
+    SCIP_SOL* sol,                     // Solution
+    ProblemData& probdata,             // Problem data
+    geas::solver& cp,                  // CP solver
+    const AssumptionStage stage,       // Stage of the separator that found the first nogood
+    Vector<SCIP_VAR*> blocked_vars,    // Sorted list of variables in the first nogood
+    SCIP_RESULT* result                // Pointer to store the result
+)
+{
+    for (Int nb_nogoods = 0; nb_nogoods < MAX_EXTRA_NOGOODS && *result != SCIP_CUTOFF; ++nb_nogoods)
+    {
+        // Make assumptions.
+        debugln("   Assumptions for extra nogood:");
+        cp.clear_assumptions();
+        if (make_unblocked_assumptions(scip, sol, probdata, cp, stage, blocked_vars))
+        {
+            // Get time remaining.
+            auto time_remaining = get_time_remaining(scip);
+            if (time_remaining <= 0)
+            {
+                break;
+            }
+            time_remaining = std::min<Float>(time_remaining, MAX_EXTRA_NOGOOD_DURATION);
+
+            // Solve.
+            const auto cp_result = cp.solve(limits{.time = time_remaining,
+                                                   .conflicts = MAX_EXTRA_NOGOOD_CONFLICTS});
+            if (cp_result != geas::solver::UNSAT)
+            {
+                break;
+            }
+        }
+
+        // Get nogood.
+        auto nogood = get_nogood(cp, probdata);
+        const auto nb_blocked_vars = blocked_vars.size();
+        block_nogood_vars(nogood, blocked_vars);
+        if (!nogood.vars.empty() && blocked_vars.size() == nb_blocked_vars)
+        {
+            break;
+        }
+
+        // Add nogood.
+        SCIP_RESULT nogood_result;
+        SCIP_CALL(add_nogood(scip, probdata, nogood, false, &nogood_result));
+        *result = combine_nogood_results(*result, nogood_result);
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Add an optimality cut obj >= v - M * (number of Boolean literals differing from the solution), where v
+// is the highest objective value proven by a budgeted search to be a lower bound under the Boolean
+// variables of the solution and M = v - lb(obj). The literals come from the conflict of the proof.
+// Returns false without adding a cut if the Boolean variables cannot be assumed, no bound above the
+// global lower bound is proven or the conflict involves integer variables.
+static
+SCIP_RETCODE add_optimality_cut(
+    SCIP* scip,                       // SCIP
+    SCIP_SOL* sol,                    // Solution
+    Nutmeg::ProblemData& probdata,    // Problem data
+    geas::solver& cp,                 // CP solver
+    bool& is_added,                   // Pointer to store whether the cut is added
+    SCIP_RESULT* result               // Pointer to store the result
+)
+{
+    using namespace Nutmeg;
+
+    // Get objective variable.
+    is_added = false;
+    auto obj_var = probdata.mip_int_vars_[probdata.obj_var_idx_];
+    const auto& cp_obj_var = probdata.cp_int_vars_[probdata.obj_var_idx_];
+    const auto obj_lb = static_cast<Int>(SCIPceil(scip, SCIPvarGetLbGlobal(obj_var)));
+    auto obj_ub = static_cast<Int>(SCIPfloor(scip, SCIPvarGetUbGlobal(obj_var)));
+    const auto start_time = SCIPgetSolvingTime(scip);
+
+    // Search for the highest provable lower bound, starting just above the value in the solution.
+    Int proven = obj_lb;
+    NogoodData proof;
+    auto candidate = std::max<Int>(obj_lb + 1,
+                                   static_cast<Int>(SCIPfloor(scip, SCIPgetSolVal(scip, sol, obj_var))) + 1);
+    for (Int search = 0; search < MAX_OPTIMALITY_CUT_SEARCHES && proven < obj_ub && candidate <= obj_ub; ++search)
+    {
+        // Assume the Boolean variables and a lower objective value.
+        cp.clear_assumptions();
+        if (!make_bool_assumptions(scip, sol, probdata, cp))
+        {
+            break;
+        }
+        candidate = std::max<Int>(candidate, cp_obj_var.lb(cp.data));
+        if (candidate > obj_ub)
+        {
+            break;
+        }
+        geas::solver::result cp_result = geas::solver::UNSAT;
+        if (cp.assume(cp_obj_var <= candidate - 1))
+        {
+            const auto time_remaining = std::min(MAX_OPTIMALITY_CUT_DURATION - (SCIPgetSolvingTime(scip) - start_time),
+                                                 get_time_remaining(scip));
+            if (time_remaining <= 0)
+            {
+                break;
+            }
+            cp_result = cp.solve(limits{.time = time_remaining, .conflicts = MAX_OPTIMALITY_CUT_CONFLICTS});
+        }
+
+        // Update the bounds.
+        if (cp_result == geas::solver::UNSAT)
+        {
+            proven = candidate;
+            proof = get_nogood(cp, probdata);
+        }
+        else if (cp_result == geas::solver::SAT)
+        {
+            obj_ub = cp_obj_var.lb(cp.data);
+        }
+        else
+        {
+            obj_ub = candidate - 1;
+        }
+        candidate = proven + (obj_ub - proven + 1) / 2;
+    }
+    cp.clear_assumptions();
+    if (proven <= obj_lb)
+    {
+        return SCIP_OKAY;
+    }
+
+    // Get the bound on the objective variable from the proof.
+    Int obj_bound = obj_lb;
+    for (size_t idx = 0; idx < proof.vars.size(); ++idx)
+        if (proof.vars[idx] == obj_var)
+        {
+            if (proof.signs[idx] != SCIP_BOUNDTYPE_LOWER)
+            {
+                return SCIP_OKAY;
+            }
+            obj_bound = std::max<Int>(obj_bound, SCIPround(scip, proof.bounds[idx]));
+        }
+        else if (!SCIPvarIsBinary(proof.vars[idx]))
+        {
+            return SCIP_OKAY;
+        }
+    if (obj_bound <= obj_lb)
+    {
+        return SCIP_OKAY;
+    }
+
+    // Create cut. A literal of the proof holds if the Boolean variable differs from the solution.
+    const SCIP_Real big_m = obj_bound - obj_lb;
+    SCIP_Real rhs = obj_bound;
+    Vector<SCIP_VAR*> vars{obj_var};
+    Vector<SCIP_Real> coeffs{1.0};
+    for (size_t idx = 0; idx < proof.vars.size(); ++idx)
+        if (proof.vars[idx] != obj_var)
+        {
+            vars.push_back(proof.vars[idx]);
+            if (proof.signs[idx] == SCIP_BOUNDTYPE_LOWER)
+            {
+                coeffs.push_back(big_m);
+            }
+            else
+            {
+                coeffs.push_back(-big_m);
+                rhs -= big_m;
+            }
+        }
+
+    // Fall back to the nogood if the cut does not cut off the solution, since the solution would
+    // otherwise be enforced again.
+    SCIP_Real activity = 0.0;
+    for (size_t idx = 0; idx < vars.size(); ++idx)
+    {
+        activity += coeffs[idx] * SCIPgetSolVal(scip, sol, vars[idx]);
+    }
+    if (SCIPisFeasGE(scip, activity, rhs))
+    {
+        debugln("   Optimality cut obj >= {} is not violated", obj_bound);
+        return SCIP_OKAY;
+    }
+
+    // Add cut.
+    SCIP_CONS* cons = nullptr;
+    SCIP_CALL(SCIPcreateConsBasicLinear(scip,
+                                        &cons,
+                                        "",
+                                        vars.size(),
+                                        vars.data(),
+                                        coeffs.data(),
+                                        rhs,
+                                        SCIPinfinity(scip)));
+    SCIP_CALL(SCIPaddCons(scip, cons));
+    SCIP_CALL(SCIPreleaseCons(scip, &cons));
+    debugln("   Adding optimality cut obj >= {} over {} literals", obj_bound, vars.size() - 1);
+
+    // Keep the disjunction for solving again after the model is changed.
+    probdata.nogoods_.push_back(proof);
+
+    // Done.
+    is_added = true;
+    *result = SCIP_CONSADDED;
+    return SCIP_OKAY;
+}
+
+static
+SCIP_RETCODE geas_separate(
+    SCIP* scip,                       // SCIP
+    Nutmeg::ProblemData& probdata,    // Problem data
+    SCIP_RESULT* result               // Pointer to store the result
+)
+{
+    using namespace Nutmeg;
+
+    constexpr SCIP_SOL* sol = nullptr;
+
+    // Print.
+    debugln("Starting Geas MIP separator on solution with obj {:.6f} (LP {:.6f}) at node "
+            "{}, depth {}:",
+            SCIPgetSolOrigObj(scip, sol),
+            SCIPgetLPObjval(scip),
+            SCIPnodeGetNumber(SCIPgetCurrentNode(scip)),
+            SCIPgetDepth(scip));
+
+    // Get problem.
+    auto& cp = probdata.cp_;
     const auto is_fractional = sol_is_fractional(scip, nullptr, probdata);
 
+    // Get parameters.
+    SCIP_Bool multi_cut = FALSE;
+    SCIP_CALL(SCIPgetBoolParam(scip, "constraints/" CONSHDLR_NAME "/multicut", &multi_cut));
+    SCIP_Bool optimality_cuts = FALSE;
+    SCIP_CALL(SCIPgetBoolParam(scip, "constraints/" CONSHDLR_NAME "/optimalitycuts", &optimality_cuts));
+
     // Print solution.
 #ifdef PRINT_DEBUG
     print_sol(scip, sol, probdata);
@@ -969,9 +1898,25 @@ SCIP_RETCODE geas_separate(
 
     // Allocate space to store the result.
     bool lp_early_stop = false;
+    auto stage = AssumptionStage::BoolVars;
     geas::solver::result cp_result;
     Float time_remaining;
 
+    // At an integral solution, check the components of the CP subproblem separately. The nogood of an
+    // infeasible component only involves its own variables.
+    if (!is_fractional && probdata.cp_components_.size() >= 2)
+    {
+        stage = AssumptionStage::AllVars;
+        cp_result = check_components(scip, sol, probdata, cp, true);
+        if (cp_result == geas::solver::SAT)
+        {
+            debugln("   Feasible");
+            *result = SCIP_FEASIBLE;
+            return SCIP_OKAY;
+        }
+        goto CHECK_RESULT;
+    }
+
     // Check CP subproblem only with assumptions on Boolean variables.
     {
         // Make assumptions.
@@ -1019,6 +1964,8 @@ SCIP_RETCODE geas_separate(
     // If satisfied, also make assumptions on objective variable.
     if (cp_result == geas::solver::SAT)
     {
+        stage = AssumptionStage::BoolAndObjVars;
+
         // Make additional assumptions.
         debugln("   Assumptions:");
         cp.clear_assumptions();
@@ -1065,6 +2012,8 @@ SCIP_RETCODE geas_separate(
     // If satisfied, make assumptions on all MIP variables.
     if (cp_result == geas::solver::SAT)
     {
+        stage = AssumptionStage::AllVars;
+
         // Make additional assumptions.
         debugln("   Assumptions:");
         cp.clear_assumptions();
@@ -1109,120 +2058,37 @@ SCIP_RETCODE geas_separate(
     }
 
     // Create nogood.
+    CHECK_RESULT:
     if (cp_result == geas::solver::UNSAT)
     {
         GET_CONFLICT:
 
         // Make nogood.
         auto nogood = get_nogood(cp, probdata);
-
-        // If there is zero literals, the problem is infeasible.
-        if (nogood.vars.size() == 0)
+        Vector<SCIP_VAR*> blocked_vars;
+        if (multi_cut)
         {
-            scip_assert(SCIPinterruptSolve(scip));
-            *result = SCIP_CUTOFF;
-            return SCIP_OKAY;
+            block_nogood_vars(nogood, blocked_vars);
         }
 
-        // If there is one literal, enforce the bound change globally.
-        if (nogood.vars.size() == 1)
+        // Add an optimality cut instead of the nogood if the Boolean variables are feasible but the
+        // objective value is not.
+        bool is_optimality_cut_added = false;
+        if (optimality_cuts && stage == AssumptionStage::BoolAndObjVars)
         {
-            // Change bound.
-            auto var = nogood.vars[0];
-            const auto sign = nogood.signs[0];
-            const auto bound = nogood.bounds[0];
-            if (sign == SCIP_BOUNDTYPE_UPPER)
-            {
-                debug_assert(SCIPisLT(scip, bound, SCIPvarGetUbLocal(var)));
-                scip_assert(SCIPchgVarUbGlobal(scip, var, bound));
-            }
-            else
-            {
-                debug_assert(SCIPisGT(scip, bound, SCIPvarGetLbLocal(var)));
-                if (var == probdata.mip_int_vars_[probdata.obj_var_idx_])
-                {
-                    if (SCIPisGT(scip, bound, SCIPvarGetUbLocal(var)))
-                    {
-                        probdata.cp_dual_bound_ = bound;
-                        *result = SCIP_CUTOFF;
-                        return SCIP_OKAY;
-                    }
-                    else
-                    {
-                        scip_assert(SCIPchgVarLbGlobal(scip, var, bound));
-                    }
-                }
-                else
-                {
-                    scip_assert(SCIPchgVarLbGlobal(scip, var, bound));
-                }
-            }
-
-            // Reduced domain.
-            *result = SCIP_REDUCEDDOM;
-            return SCIP_OKAY;
+            SCIP_CALL(add_optimality_cut(scip, sol, probdata, cp, is_optimality_cut_added, result));
         }
-
-        // Create cut.
-        if (nogood.all_binary)
+        if (!is_optimality_cut_added)
         {
-            // Get negated variables.
-            for (size_t idx = 0; idx < nogood.vars.size(); ++idx)
-            {
-                debug_assert(SCIPvarIsBinary(nogood.vars[idx]));
-                if (nogood.signs[idx] == SCIP_BOUNDTYPE_UPPER)
-                {
-                    debug_assert(nogood.bounds[idx] == 0);
-                    scip_assert(SCIPgetNegatedVar(scip,
-                                                  nogood.vars[idx],
-                                                  &nogood.vars[idx]));
-                }
-            }
-
-            // Add constraint.
-            SCIP_CONS* cons = nullptr;
-            scip_assert(SCIPcreateConsBasicLogicor(scip,
-                                                   &cons,
-#ifndef NDEBUG
-                                                   nogood.name.c_str(),
-#else
-                                                   "",
-#endif
-                                                   nogood.vars.size(),
-                                                   nogood.vars.data()));
-            debug_assert(cons);
-            scip_assert(SCIPaddCons(scip, cons));
-            scip_assert(SCIPreleaseCons(scip, &cons));
-            debugln("   Adding nogood with only binary variables");
-
-            // Created constraint.
-            *result = SCIP_CONSADDED;
-            return SCIP_OKAY;
+            SCIP_CALL(add_nogood(scip, probdata, nogood, false, result));
         }
-        else
+
+        // Add more nogoods over other variables.
+        if (multi_cut)
         {
-            // Add constraint.
-            SCIP_CONS* cons = nullptr;
-            scip_assert(SCIPcreateConsBasicBounddisjunction(scip,
-                                                            &cons,
-#ifndef NDEBUG
-                                                            nogood.name.c_str(),
-#else
-                                                            "",
-#endif
-                                                            nogood.vars.size(),
-                                                            nogood.vars.data(),
-                                                            nogood.signs.data(),
-                                                            nogood.bounds.data()));
-            debug_assert(cons);
-            scip_assert(SCIPaddCons(scip, cons));
-            scip_assert(SCIPreleaseCons(scip, &cons));
-            debugln("   Adding nogood with integer variables");
-
-            // Created constraint.
-            *result = SCIP_INFEASIBLE; // Stuck in infinite loop if returning CONSADDED
-            return SCIP_OKAY;
+            SCIP_CALL(add_extra_nogoods(scip, sol, probdata, cp, stage, std::move(blocked_vars), result));
         }
+        return SCIP_OKAY;
     }
     else if (cp_result == geas::solver::SAT)
     {
@@ -1254,10 +2120,95 @@ SCIP_RETCODE geas_separate(
     return SCIP_OKAY;
 }
 
+// Information stored with bound changes made by the propagator: the index of the Boolean or integer
+// variable, the type of variable and the type of bound. The bound is stored relative to the variable in
+// Nutmeg because SCIP reports it on the active variable, which can be negated or aggregated.
+static inline
+Int make_inferinfo(const Int idx, const bool is_int, const bool is_lb)
+{
+    release_assert(0 <= idx && idx <= (INT_MAX >> 2), "Variable index {} is too large to store in a bound change", idx);
+    return (idx << 2) | (static_cast<Int>(is_int) << 1) | static_cast<Int>(is_lb);
+}
+static inline
+Int get_inferinfo_idx(const Int inferinfo)
+{
+    return inferinfo >> 2;
+}
+static inline
+bool get_inferinfo_is_int(const Int inferinfo)
+{
+    return inferinfo & 2;
+}
+static inline
+bool get_inferinfo_is_lb(const Int inferinfo)
+{
+    return inferinfo & 1;
+}
+
+// Add the bounds falsifying every literal of a nogood from Geas to the conflict analysis of SCIP
+static
+SCIP_RETCODE add_conflict_bounds(
+    SCIP* scip,                      // SCIP
+    ProblemData& probdata,           // Problem data
+    vec<geas::patom_t>& conflict,    // Nogood in CP
+    SCIP_BDCHGIDX* bdchgidx          // Bound change index, or null for the current bounds
+)
+{
+    NogoodData nogood;
+    add_nogood_literals(conflict, probdata, nogood);
+    for (size_t k = 0; k < nogood.vars.size(); ++k)
+        if (nogood.signs[k] == SCIP_BOUNDTYPE_LOWER)
+        {
+            SCIP_CALL(SCIPaddConflictRelaxedUb(scip, nogood.vars[k], bdchgidx, nogood.bounds[k] - 1));
+        }
+        else
+        {
+            SCIP_CALL(SCIPaddConflictRelaxedLb(scip, nogood.vars[k], bdchgidx, nogood.bounds[k] + 1));
+        }
+    return SCIP_OKAY;
+}
+
+// Change a bound in the MIP on behalf of the Geas constraint
+static
+SCIP_RETCODE infer_bound(
+    SCIP* scip,                  // SCIP
+    SCIP_CONS* cons,             // Geas constraint
+    SCIP_VAR* var,               // Variable
+    SCIP_BOUNDTYPE boundtype,    // Type of bound to change
+    const Float bound,           // New bound
+    const Int idx,               // Index of the Boolean or integer variable
+    const bool is_int,           // Is the variable an integer variable?
+    SCIP_RESULT* result          // Pointer to store the result
+)
+{
+    SCIP_Bool infeasible = FALSE;
+    SCIP_Bool tightened = FALSE;
+    if (boundtype == SCIP_BOUNDTYPE_LOWER)
+    {
+        const auto inferinfo = make_inferinfo(idx, is_int, true);
+        SCIP_CALL(SCIPinferVarLbCons(scip, var, bound, cons, inferinfo, FALSE, &infeasible, &tightened));
+    }
+    else
+    {
+        const auto inferinfo = make_inferinfo(idx, is_int, false);
+        SCIP_CALL(SCIPinferVarUbCons(scip, var, bound, cons, inferinfo, FALSE, &infeasible, &tightened));
+    }
+    if (infeasible)
+    {
+        *result = SCIP_CUTOFF;
+    }
+    else if (tightened && *result != SCIP_CUTOFF)
+    {
+        *result = SCIP_REDUCEDDOM;
+    }
+    return SCIP_OKAY;
+}
+
 // Propagation of a solution
 static
 SCIP_RETCODE geas_propagate(
     SCIP* scip,            // SCIP
+    SCIP_CONS* cons,       // Geas constraint
     SCIP_RESULT* result    // Pointer to store the result
 )
 {
@@ -1277,23 +2228,28 @@ SCIP_RETCODE geas_propagate(
     int_vars_monitor.reset();
     debugln("   Assumptions:");
     cp.clear_assumptions();
-    if (!make_bounds_assumptions(scip, probdata, cp))
+    if (!make_bounds_assumptions(scip, probdata, cp, nullptr))
     {
         debugln("   Assumptions infeasible");
-        *result = SCIP_CUTOFF;
-        return SCIP_OKAY;
+        goto GET_CONFLICT;
     }
     debugln("   Assumptions completed");
 
-    // Propagate.
+    // Propagate. If the assumptions are inconsistent, search until Geas returns the conflict over the
+    // assumptions.
     if (!cp.is_consistent())
     {
         debugln("   Propagation infeasible");
+        if (cp.solve(limits{.time = MAX_PROPAGATION_CONFLICT_DURATION, .conflicts = 1}) == geas::solver::UNSAT)
+        {
+            goto GET_CONFLICT;
+        }
         *result = SCIP_CUTOFF;
         return SCIP_OKAY;
     }
 
-    // Propagate CP domain changes in the MIP.
+    // Propagate CP domain changes in the MIP. Each bound change records the variable and direction so
+    // that its explanation can be recovered from Geas during conflict analysis.
     debugln("   Propagating");
     for (auto idx : bool_vars_monitor.updated_lbs())
     {
@@ -1306,8 +2262,11 @@ SCIP_RETCODE geas_propagate(
         if (SCIPisGT(scip, bound, SCIPvarGetLbLocal(mip_var)))
         {
             debugln("   {} >= {}", probdata.bool_vars_name_[idx], bound);
-            scip_assert(SCIPchgVarLb(scip, mip_var, bound));
-            *result = SCIP_REDUCEDDOM;
+            SCIP_CALL(infer_bound(scip, cons, mip_var, SCIP_BOUNDTYPE_LOWER, bound, idx, false, result));
+            if (*result == SCIP_CUTOFF)
+            {
+                return SCIP_OKAY;
+            }
         }
     }
     for (auto idx : bool_vars_monitor.updated_ubs())
@@ -1321,8 +2280,11 @@ SCIP_RETCODE geas_propagate(
         if (SCIPisLT(scip, bound, SCIPvarGetUbLocal(mip_var)))
         {
             debugln("   {} <= {}", probdata.bool_vars_name_[idx], bound);
-            scip_assert(SCIPchgVarUb(scip, mip_var, bound));
-            *result = SCIP_REDUCEDDOM;
+            SCIP_CALL(infer_bound(scip, cons, mip_var, SCIP_BOUNDTYPE_UPPER, bound, idx, false, result));
+            if (*result == SCIP_CUTOFF)
+            {
+                return SCIP_OKAY;
+            }
         }
     }
     for (auto idx : int_vars_monitor.updated_lbs())
@@ -1336,8 +2298,11 @@ SCIP_RETCODE geas_propagate(
         if (SCIPisGT(scip, bound, SCIPvarGetLbLocal(mip_var)))
         {
             debugln("   {} >= {}", probdata.int_vars_name_[idx], bound);
-            scip_assert(SCIPchgVarLb(scip, mip_var, bound));
-            *result = SCIP_REDUCEDDOM;
+            SCIP_CALL(infer_bound(scip, cons, mip_var, SCIP_BOUNDTYPE_LOWER, bound, idx, true, result));
+            if (*result == SCIP_CUTOFF)
+            {
+                return SCIP_OKAY;
+            }
         }
     }
     for (auto idx : int_vars_monitor.updated_ubs())
@@ -1351,13 +2316,130 @@ SCIP_RETCODE geas_propagate(
         if (SCIPisLT(scip, bound, SCIPvarGetUbLocal(mip_var)))
         {
             debugln("   {} <= {}", probdata.int_vars_name_[idx], bound);
-            scip_assert(SCIPchgVarUb(scip, mip_var, bound));
-            *result = SCIP_REDUCEDDOM;
+            SCIP_CALL(infer_bound(scip, cons, mip_var, SCIP_BOUNDTYPE_UPPER, bound, idx, true, result));
+            if (*result == SCIP_CUTOFF)
+            {
+                return SCIP_OKAY;
+            }
         }
     }
 
     // Done.
     return SCIP_OKAY;
+
+    // Add the nogood of the failure so that the rest of the tree is pruned too.
+    GET_CONFLICT:
+    {
+        auto nogood = get_nogood(cp, probdata);
+        SCIP_CALL(add_nogood(scip, probdata, nogood, true, result));
+        *result = SCIP_CUTOFF;
+        return SCIP_OKAY;
+    }
+}
+
+// Explain a bound change made by the propagator. The explanation is found by assuming the bounds that held
+// before the bound change together with the negation of the propagated atom, and translating the conflict
+// returned by Geas into MIP bounds. Conflict analysis runs between the callbacks using Geas, so the
+// assumptions are cleared on return rather than restored, and every callback makes its own assumptions
+// before calling Geas. Nogoods learned by Geas while explaining stay in it and are valid for the model.
+static
+SCIP_RETCODE geas_resolve_propagation(
+    SCIP* scip,                  // SCIP
+    const Int inferinfo,         // Information stored with the bound change
+    SCIP_BDCHGIDX* bdchgidx,     // Bound change index
+    SCIP_RESULT* result          // Pointer to store the result
+)
+{
+    using namespace Nutmeg;
+
+    // Get problem data.
+    auto& probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(scip));
+    auto& cp = probdata.cp_;
+
+    // Get the propagated atom.
+    const auto idx = get_inferinfo_idx(inferinfo);
+    const auto is_lb = get_inferinfo_is_lb(inferinfo);
+    geas::patom_t atom;
+    if (get_inferinfo_is_int(inferinfo))
+    {
+        const auto& cp_var = probdata.cp_int_vars_[idx];
+        auto mip_var = probdata.mip_int_vars_[idx];
+        atom = is_lb ?
+               cp_var >= static_cast<Int>(SCIPround(scip, SCIPgetVarLbAtIndex(scip, mip_var, bdchgidx, TRUE))) :
+               cp_var <= static_cast<Int>(SCIPround(scip, SCIPgetVarUbAtIndex(scip, mip_var, bdchgidx, TRUE)));
+    }
+    else
+    {
+        const auto& cp_var = probdata.cp_bool_vars_[idx];
+        atom = is_lb ? cp_var : ~cp_var;
+    }
+
+    // Propagate the bounds before the bound change with the negation of the atom. If the assumptions are
+    // inconsistent, search until Geas returns the conflict over the assumptions, as in the propagator.
+    cp.clear_assumptions();
+    if (make_bounds_assumptions(scip, probdata, cp, bdchgidx) && cp.assume(~atom) &&
+        (cp.is_consistent() ||
+         cp.solve(limits{.time = MAX_PROPAGATION_CONFLICT_DURATION, .conflicts = 1}) != geas::solver::UNSAT))
+    {
+        debugln("   Failed to explain propagation");
+        cp.clear_assumptions();
+        *result = SCIP_DIDNOTFIND;
+        return SCIP_OKAY;
+    }
+
+    // Get the conflict.
+    vec<geas::patom_t> conflict;
+    cp.get_conflict(conflict);
+    cp.clear_assumptions();
+    if (conflict.size() == 0)
+    {
+        debugln("   Failed to explain propagation");
+        *result = SCIP_DIDNOTFIND;
+        return SCIP_OKAY;
+    }
+
+    // Drop the literals bounding the propagated variable in the direction of the atom, which include the
+    // atom and weaker versions of it, so that the reason does not contain the bound it explains.
+    vec<geas::patom_t> reason;
+    for (const auto conflict_atom : conflict)
+        if (conflict_atom.pid != atom.pid)
+        {
+            reason.push(conflict_atom);
+        }
+
+    // Add the reason.
+    SCIP_CALL(add_conflict_bounds(scip, probdata, reason, bdchgidx));
+
+    // Done.
+    *result = SCIP_SUCCESS;
+    return SCIP_OKAY;
+}
+
+// Solving process initialization method of constraint handler, called at the start of every run
+static
+SCIP_DECL_CONSINITSOL(consInitsolGeas)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(conshdlr);
+    debug_assert(strcmp(SCIPconshdlrGetName(conshdlr), CONSHDLR_NAME) == 0);
+
+    // Count the nogoods from the start of the run, whether SCIP or the constraint handler restarted.
+    if (auto probdata = reinterpret_cast<ProblemData*>(SCIPgetProbData(scip)); probdata)
+    {
+        probdata->nb_run_nogoods_ = 0;
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Keep the limit on restarts in SCIP equal to the limit on restarts after finding nogoods
+static
+SCIP_DECL_PARAMCHGD(paramChgdMaxRestartsGeas)
+{
+    SCIP_CALL(SCIPsetIntParam(scip, "presolving/maxrestarts", SCIPparamGetInt(param)));
+    return SCIP_OKAY;
 }
 
 // Copy method for constraint handler
@@ -1492,7 +2574,30 @@ SCIP_DECL_CONSPROP(consPropGeas)
     *result = SCIP_DIDNOTFIND;
 
     // Start propagator.
-    SCIP_CALL(geas_propagate(scip, result));
+    SCIP_CALL(geas_propagate(scip, conss[0], result));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Propagation conflict resolving method of constraint handler
+static
+SCIP_DECL_CONSRESPROP(consRespropGeas)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(conshdlr);
+    debug_assert(strcmp(SCIPconshdlrGetName(conshdlr), CONSHDLR_NAME) == 0);
+    debug_assert(cons);
+    debug_assert(infervar);
+    debug_assert(bdchgidx);
+    debug_assert(result);
+
+    // Start.
+    *result = SCIP_DIDNOTFIND;
+
+    // Explain propagation.
+    SCIP_CALL(geas_resolve_propagation(scip, inferinfo, bdchgidx, result));
 
     // Done.
     return SCIP_OKAY;
@@ -1662,6 +2767,9 @@ SCIP_RETCODE SCIPincludeConshdlrGeas(
 //    SCIP_CALL(SCIPsetConshdlrExitsol(scip,
 //                                     conshdlr,
 //                                     consExitsolGeas));
+    SCIP_CALL(SCIPsetConshdlrInitsol(scip,
+                                     conshdlr,
+                                     consInitsolGeas));
     SCIP_CALL(SCIPsetConshdlrCopy(scip,
                                   conshdlr,
                                   conshdlrCopyGeas,
@@ -1675,6 +2783,58 @@ SCIP_RETCODE SCIPincludeConshdlrGeas(
                                   CONSHDLR_PROPFREQ,
                                   CONSHDLR_DELAYPROP,
                                   CONSHDLR_PROP_TIMING));
+    SCIP_CALL(SCIPsetConshdlrResprop(scip,
+                                     conshdlr,
+                                     consRespropGeas));
+
+    // Add parameters.
+    SCIP_CALL(SCIPaddIntParam(scip,
+                              "constraints/" CONSHDLR_NAME "/restartnogoods",
+                              "number of nogoods and fixings found in a run that trigger a restart (0: never restart)",
+                              nullptr,
+                              FALSE,
+                              RESTART_NOGOODS,
+                              0,
+                              INT_MAX,
+                              nullptr,
+                              nullptr));
+    SCIP_CALL(SCIPaddIntParam(scip,
+                              "constraints/" CONSHDLR_NAME "/restartmaxnodes",
+                              "number of nodes in a run after which it is not restarted",
+                              nullptr,
+                              FALSE,
+                              RESTART_MAX_NODES,
+                              1,
+                              INT_MAX,
+                              nullptr,
+                              nullptr));
+    SCIP_CALL(SCIPaddIntParam(scip,
+                              "constraints/" CONSHDLR_NAME "/maxrestarts",
+                              "maximum number of runs restarted after finding nogoods, which also limits presolving/maxrestarts (-1: no limit)",
+                              nullptr,
+                              FALSE,
+                              MAX_RESTARTS,
+                              -1,
+                              INT_MAX,
+                              paramChgdMaxRestartsGeas,
+                              nullptr));
+    SCIP_CALL(SCIPaddBoolParam(scip,
+                               "constraints/" CONSHDLR_NAME "/multicut",
+                               "should extra nogoods over other variables be added after each nogood found by the separator?",
+                               nullptr,
+                               FALSE,
+                               MULTI_CUT,
+                               nullptr,
+                               nullptr));
+    SCIP_CALL(SCIPaddBoolParam(scip,
+                               "constraints/" CONSHDLR_NAME "/optimalitycuts",
+                               "should an optimality cut replace the nogood when the Boolean variables are feasible but the objective value is not?",
+                               nullptr,
+                               FALSE,
+                               OPTIMALITY_CUTS,
+                               nullptr,
+                               nullptr));
+    SCIP_CALL(SCIPsetIntParam(scip, "presolving/maxrestarts", MAX_RESTARTS));
 
     // Done.
     return SCIP_OKAY;
@@ -7,22 +7,6 @@
 #include "geas/solver/solver.h"
 #include "geas/constraints/builtins.h"
 
-namespace Nutmeg
-{
-
-struct NogoodData
-{
-    Vector<SCIP_VAR*> vars;
-    Vector<SCIP_BOUNDTYPE> signs;
-    Vector<SCIP_Real> bounds;
-    bool all_binary{true};
-#ifndef NDEBUG
-    String name;
-#endif
-};
-
-}
-
 // Create the constraint handler
 extern
 SCIP_RETCODE SCIPincludeConshdlrGeas(
@@ -75,11 +59,25 @@ bool make_obj_assumptions(
     geas::solver& cp                  // CP solver
 );
 
+void add_nogood_literals(
+    vec<geas::patom_t>& conflict,     // Nogood in CP
+    Nutmeg::ProblemData& probdata,    // Problem data
+    Nutmeg::NogoodData& nogood        // Nogood in MIP
+);
+
 Nutmeg::NogoodData get_nogood(
     geas::solver& cp,                // CP solver
     Nutmeg::ProblemData& probdata    // Problem data
 );
 
+// Add the solution of the CP solver to the MIP as a solution found by a primal heuristic, and store it as
+// the solution of the model if SCIP accepts it
+SCIP_RETCODE add_cp_solution(
+    SCIP* scip,                       // SCIP
+    SCIP_HEUR* heur,                  // Primal heuristic
+    Nutmeg::ProblemData& probdata     // Problem data
+);
+
 #ifndef NDEBUG
 Nutmeg::String make_nogood_name(
     Nutmeg::ProblemData& probdata,    // Problem data
@@ -0,0 +1,256 @@
+#include "DataFile.h"
+#include <charconv>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Nutmeg
+{
+
+static inline bool is_space(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static inline bool is_digit(const char c)
+{
+    return '0' <= c && c <= '9';
+}
+
+static inline bool is_identifier_char(const char c)
+{
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || is_digit(c) || c == '_';
+}
+
+static inline StringView trim(StringView text)
+{
+    while (!text.empty() && is_space(text.front()))
+        text.remove_prefix(1);
+    while (!text.empty() && is_space(text.back()))
+        text.remove_suffix(1);
+    return text;
+}
+
+MappedFile::MappedFile(const String& file_path) :
+    data_(nullptr),
+    size_(0)
+{
+    // Open the file.
+    const auto fd = open(file_path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        err("Cannot open data file {}", file_path);
+    }
+
+    // Get the file size.
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0)
+    {
+        close(fd);
+        err("Cannot get size of data file {}", file_path);
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+
+    // Map the file into memory. An empty file cannot be mapped and is left as an empty view.
+    if (size_ > 0)
+    {
+        auto data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            close(fd);
+            err("Cannot map data file {} into memory", file_path);
+        }
+        madvise(data, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(data);
+    }
+
+    // The mapping stays valid after closing the file.
+    close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+    {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+StringView Tokenizer::next_line()
+{
+    const auto start = it_;
+    while (it_ != end_ && *it_ != '\n')
+        ++it_;
+    auto line_end = it_;
+    if (it_ != end_)
+        ++it_;
+    if (line_end != start && *(line_end - 1) == '\r')
+        --line_end;
+    return StringView(start, line_end - start);
+}
+
+StringView Tokenizer::next_token()
+{
+    while (it_ != end_ && is_space(*it_))
+        ++it_;
+    const auto start = it_;
+    while (it_ != end_ && !is_space(*it_))
+        ++it_;
+    return StringView(start, it_ - start);
+}
+
+bool Tokenizer::next_int(Int& val)
+{
+    // Skip to the start of the next number.
+    while (it_ != end_ && !is_digit(*it_) && !(*it_ == '-' && it_ + 1 != end_ && is_digit(*(it_ + 1))))
+        ++it_;
+    if (it_ == end_)
+    {
+        return false;
+    }
+
+    // Parse the number.
+    const auto [ptr, ec] = std::from_chars(it_, end_, val);
+    release_assert(ec == std::errc(), "Integer in data file is out of range");
+    it_ = ptr;
+    return true;
+}
+
+Int parse_int(const StringView text)
+{
+    const auto trimmed = trim(text);
+    Int val = 0;
+    const auto [ptr, ec] = std::from_chars(trimmed.data(), trimmed.data() + trimmed.size(), val);
+    release_assert(ec == std::errc() && ptr == trimmed.data() + trimmed.size(),
+                   "Cannot parse integer from \"{}\"", trimmed);
+    return val;
+}
+
+void parse_int_array(const StringView text, Int* output, const size_t size)
+{
+    Tokenizer tokenizer(text);
+    size_t count = 0;
+    for (Int val; tokenizer.next_int(val); ++count)
+    {
+        release_assert(count < size, "Array has more than {} elements", size);
+        output[count] = val;
+    }
+    release_assert(count == size, "Array has {} elements but expected {}", count, size);
+}
+
+Vector<Int> parse_int_array(const StringView text)
+{
+    Vector<Int> output;
+    Tokenizer tokenizer(text);
+    for (Int val; tokenizer.next_int(val);)
+    {
+        output.push_back(val);
+    }
+    return output;
+}
+
+DznFile::DznFile(const String& file_path) :
+    file_path_(file_path),
+    file_(file_path),
+    items_()
+{
+    // Scan the file once, recording the span of each item.
+    const auto text = file_.view();
+    const auto end = text.data() + text.size();
+    auto it = text.data();
+    while (true)
+    {
+        // Skip whitespace and comments.
+        while (it != end && (is_space(*it) || *it == '%'))
+        {
+            if (*it == '%')
+                while (it != end && *it != '\n')
+                    ++it;
+            else
+                ++it;
+        }
+        if (it == end)
+        {
+            break;
+        }
+
+        // Read name.
+        const auto name_start = it;
+        while (it != end && is_identifier_char(*it))
+            ++it;
+        const StringView name(name_start, it - name_start);
+        if (name.empty())
+        {
+            err("Data file {} has invalid item at offset {}", file_path_, name_start - text.data());
+        }
+
+        // Read equals sign.
+        while (it != end && is_space(*it))
+            ++it;
+        if (it == end || *it != '=')
+        {
+            err("Data file {} has item {} without a value", file_path_, name);
+        }
+        ++it;
+
+        // Read value.
+        const auto val_start = it;
+        while (it != end && *it != ';')
+            ++it;
+        if (it == end)
+        {
+            err("Data file {} has item {} without a terminating semicolon", file_path_, name);
+        }
+        items_[String(name)] = trim(StringView(val_start, it - val_start));
+        ++it;
+    }
+}
+
+bool DznFile::contains(const String& name) const
+{
+    return items_.find(name) != items_.end();
+}
+
+StringView DznFile::get(const String& name) const
+{
+    const auto it = items_.find(name);
+    if (it == items_.end())
+    {
+        err("Data file {} is missing item {}", file_path_, name);
+    }
+    return it->second;
+}
+
+Int DznFile::get_int(const String& name) const
+{
+    return parse_int(get(name));
+}
+
+Vector<Int> DznFile::get_int_array(const String& name) const
+{
+    return parse_int_array(get(name));
+}
+
+void DznFile::get_int_array(const String& name, Int* output, const size_t size) const
+{
+    parse_int_array(get(name), output, size);
+}
+
+Vector<Vector<Int>> DznFile::get_int_set_array(const String& name) const
+{
+    // Split [{a, b}, {c}, {}] into one list of integers per set.
+    Vector<Vector<Int>> output;
+    const auto text = get(name);
+    size_t pos = 0;
+    while ((pos = text.find('{', pos)) != StringView::npos)
+    {
+        const auto set_end = text.find('}', pos);
+        release_assert(set_end != StringView::npos, "Item {} has an unterminated set", name);
+        output.push_back(parse_int_array(text.substr(pos + 1, set_end - pos - 1)));
+        pos = set_end + 1;
+    }
+    return output;
+}
+
+}
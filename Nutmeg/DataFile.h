@@ -0,0 +1,99 @@
+#ifndef NUTMEG_DATAFILE_H
+#define NUTMEG_DATAFILE_H
+
+#include "Includes.h"
+#include <string_view>
+
+namespace Nutmeg
+{
+
+using StringView = std::string_view;
+
+// Read-only view of a file mapped into memory
+class MappedFile
+{
+    const char* data_;
+    size_t size_;
+
+  public:
+    // Constructors
+    MappedFile() = delete;
+    MappedFile(const String& file_path);
+    MappedFile(const MappedFile& file) = delete;
+    MappedFile(MappedFile&& file) = delete;
+    MappedFile& operator=(const MappedFile& file) = delete;
+    MappedFile& operator=(MappedFile&& file) = delete;
+    ~MappedFile();
+
+    // Get contents
+    inline StringView view() const { return StringView(data_, size_); }
+    inline size_t size() const { return size_; }
+};
+
+// Sequential reader of lines, whitespace-separated tokens and integers in a piece of text
+class Tokenizer
+{
+    const char* it_;
+    const char* end_;
+
+  public:
+    // Constructors
+    Tokenizer() = delete;
+    Tokenizer(const StringView text) noexcept : it_(text.data()), end_(text.data() + text.size()) {}
+    Tokenizer(const Tokenizer& tokenizer) noexcept = default;
+    Tokenizer(Tokenizer&& tokenizer) noexcept = default;
+    Tokenizer& operator=(const Tokenizer& tokenizer) noexcept = default;
+    Tokenizer& operator=(Tokenizer&& tokenizer) noexcept = default;
+    ~Tokenizer() noexcept = default;
+
+    // Check if all text is consumed
+    inline bool at_end() const { return it_ == end_; }
+
+    // Get the next line without the line terminator
+    StringView next_line();
+
+    // Get the next token delimited by whitespace, or an empty token if none remain
+    StringView next_token();
+
+    // Get the next integer, skipping any non-numeric separators before it
+    bool next_int(Int& val);
+};
+
+// Parse a single integer
+Int parse_int(const StringView text);
+
+// Parse every integer in a piece of text into an output range of exactly the given size
+void parse_int_array(const StringView text, Int* output, const size_t size);
+
+// Parse every integer in a piece of text
+Vector<Int> parse_int_array(const StringView text);
+
+// Items of a MiniZinc data file (name = value;) stored as views into the mapped file
+class DznFile
+{
+    String file_path_;
+    MappedFile file_;
+    HashTable<String, StringView> items_;
+
+  public:
+    // Constructors
+    DznFile() = delete;
+    DznFile(const String& file_path);
+    DznFile(const DznFile& file) = delete;
+    DznFile(DznFile&& file) = delete;
+    DznFile& operator=(const DznFile& file) = delete;
+    DznFile& operator=(DznFile&& file) = delete;
+    ~DznFile() = default;
+
+    // Get items
+    bool contains(const String& name) const;
+    StringView get(const String& name) const;
+    Int get_int(const String& name) const;
+    Vector<Int> get_int_array(const String& name) const;
+    void get_int_array(const String& name, Int* output, const size_t size) const;
+    Vector<Vector<Int>> get_int_set_array(const String& name) const;
+};
+
+}
+
+#endif
@@ -5,14 +5,30 @@
 
 #include "fmt/format.h"
 #include "scip/scip.h"
+#include <mutex>
+
+namespace Nutmeg
+{
+
+// Lock held while printing so that models solving on different threads do not interleave their output.
+// Multi-line reports hold it across their lines, which print with the lock already held.
+inline std::recursive_mutex& output_mutex()
+{
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
+}
 
 #ifndef NDEBUG
 #define println(format, ...) do { \
+    std::lock_guard<std::recursive_mutex> println_lock(Nutmeg::output_mutex()); \
     fmt::print(format "\n", ##__VA_ARGS__); \
     fflush(stdout); \
 } while (false)
 #else
 #define println(format, ...) do { \
+    std::lock_guard<std::recursive_mutex> println_lock(Nutmeg::output_mutex()); \
     fmt::print(format "\n", ##__VA_ARGS__); \
 } while (false)
 #endif
@@ -0,0 +1,325 @@
+//#define PRINT_DEBUG
+
+#include "Heuristic-CPLNS.h"
+#include "ConstraintHandler-Geas.h"
+#include "scip/pub_misc.h"
+#include <algorithm>
+#include <cmath>
+
+#define HEUR_NAME                              "cplns"
+#define HEUR_DESC   "large neighbourhood search around the incumbent in CP"
+#define HEUR_DISPCHAR                            'n' // display character of the primal heuristic
+#define HEUR_PRIORITY                        -1000200 // priority of the primal heuristic
+#define HEUR_FREQ                                  20 // frequency for calling the primal heuristic
+#define HEUR_FREQOFS                                0 // frequency offset for calling the primal heuristic
+#define HEUR_MAXDEPTH                              -1 // maximal depth level to call the primal heuristic
+#define HEUR_TIMING            SCIP_HEURTIMING_AFTERNODE // timing of the primal heuristic
+#define HEUR_USESSUBSCIP                        FALSE // does the primal heuristic use a secondary SCIP instance?
+
+#define TABLE_NAME                            "cplns"
+#define TABLE_DESC   "statistics of the CP large neighbourhood search heuristic"
+#define TABLE_POSITION                          12600 // position of the statistics table
+#define TABLE_EARLIEST_STAGE      SCIP_STAGE_SOLVING // output of the statistics table is only printed from this stage onwards
+
+#define DEFAULT_RANDSEED                           97 // initial random seed
+#define MAX_LNS_DURATION                          0.5 // maximum run time of one call
+#define MAX_LNS_CONFLICTS                         500 // maximum number of conflicts in one call
+#define INIT_RELAX_FRACTION                       0.2 // initial fraction of Boolean variables freed from the incumbent
+#define MIN_RELAX_FRACTION                       0.02 // minimum fraction of Boolean variables freed from the incumbent
+#define MAX_RELAX_FRACTION                        0.8 // maximum fraction of Boolean variables freed from the incumbent
+#define RELAX_FRACTION_FACTOR                     1.5 // factor for growing and shrinking the neighbourhood
+
+namespace Nutmeg
+{
+
+struct HeurCPLNSData
+{
+    SCIP_RANDNUMGEN* randnumgen;
+    Float relax_fraction;
+    Int nb_calls;
+    Int nb_sat;
+    Int nb_unsat;
+    Int nb_unknown;
+    Int nb_sols;
+    Float run_time;
+};
+
+static inline
+Float get_time_remaining(
+    SCIP* scip    // SCIP
+)
+{
+    SCIP_Real time_limit;
+    scip_assert(SCIPgetRealParam(scip, "limits/time", &time_limit));
+    return time_limit - SCIPgetSolvingTime(scip);
+}
+
+// Choose the Boolean variables freed from the incumbent. Half of the neighbourhoods start from the
+// variables of one constraint of the CP subproblem (such as a machine in a scheduling problem) and the
+// others are purely random.
+static
+Vector<bool> choose_neighbourhood(
+    ProblemData& probdata,            // Problem data
+    HeurCPLNSData& heurdata,          // Heuristic data
+    const Vector<Int>& candidates     // Boolean variables in the incumbent
+)
+{
+    const Int nb_candidates = candidates.size();
+    const auto nb_relaxed = std::max<Int>(1, std::lround(heurdata.relax_fraction * nb_candidates));
+    Vector<bool> is_relaxed(probdata.nb_bool_vars(), false);
+    Int nb_relaxed_so_far = 0;
+
+    // Free the variables of a constraint.
+    if (!probdata.cp_scopes_.empty() && SCIPrandomGetInt(heurdata.randnumgen, 0, 1))
+    {
+        const auto scope_idx = SCIPrandomGetInt(heurdata.randnumgen, 0, probdata.cp_scopes_.size() - 1);
+        for (auto idx : probdata.cp_scopes_[scope_idx].bool_vars_idx)
+        {
+            if (!probdata.is_pos_var(idx))
+            {
+                idx = probdata.mip_neg_vars_idx_[idx];
+            }
+            if (idx >= 2 && !is_relaxed[idx] && nb_relaxed_so_far < nb_relaxed)
+            {
+                is_relaxed[idx] = true;
+                ++nb_relaxed_so_far;
+            }
+        }
+    }
+
+    // Free random variables.
+    for (Int k = 0; k < nb_candidates && nb_relaxed_so_far < nb_relaxed; ++k)
+    {
+        // Select variables with probability proportional to the number still needed.
+        const auto idx = candidates[k];
+        if (!is_relaxed[idx] &&
+            SCIPrandomGetInt(heurdata.randnumgen, 0, nb_candidates - k - 1) < nb_relaxed - nb_relaxed_so_far)
+        {
+            is_relaxed[idx] = true;
+            ++nb_relaxed_so_far;
+        }
+    }
+
+    // Done.
+    return is_relaxed;
+}
+
+// Execution method of primal heuristic. The Boolean variables outside a neighbourhood are fixed to their
+// values in the incumbent and the CP solver searches for a better solution. The neighbourhood grows when
+// it is proven to contain no better solution and shrinks when the search runs out of conflicts.
+static
+SCIP_DECL_HEUREXEC(heurExecCPLNS)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(heur);
+    debug_assert(strcmp(SCIPheurGetName(heur), HEUR_NAME) == 0);
+    debug_assert(result);
+    *result = SCIP_DIDNOTRUN;
+
+    // Get problem data.
+    auto& probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(scip));
+    auto& cp = probdata.cp_;
+    auto& heurdata = *reinterpret_cast<HeurCPLNSData*>(SCIPheurGetData(heur));
+    const auto& cp_obj_var = probdata.cp_int_vars_[probdata.obj_var_idx_];
+    const auto incumbent_obj = probdata.sol_.int_vars_sol_[probdata.obj_var_idx_];
+
+    // Only run with an incumbent.
+    if (incumbent_obj == std::numeric_limits<Int>::max())
+    {
+        return SCIP_OKAY;
+    }
+
+    // Get time remaining.
+    const auto start_time = SCIPgetSolvingTime(scip);
+    const auto time_remaining = std::min<Float>(MAX_LNS_DURATION, get_time_remaining(scip));
+    if (time_remaining <= 0)
+    {
+        return SCIP_OKAY;
+    }
+    ++heurdata.nb_calls;
+    *result = SCIP_DIDNOTFIND;
+
+    // Choose neighbourhood.
+    Vector<Int> candidates;
+    for (Int idx = 2; idx < probdata.nb_bool_vars(); ++idx)
+        if (probdata.is_pos_var(idx))
+        {
+            candidates.push_back(idx);
+        }
+    const auto is_relaxed = choose_neighbourhood(probdata, heurdata, candidates);
+    debugln("Starting CP LNS heuristic with obj < {} and {:.1f}% of Boolean variables free",
+            incumbent_obj,
+            100.0 * heurdata.relax_fraction);
+
+    // Make assumptions.
+    auto cp_result = geas::solver::UNSAT;
+    cp.clear_assumptions();
+    if (!cp.assume(cp_obj_var <= incumbent_obj - 1))
+    {
+        goto EXIT;
+    }
+    for (const auto idx : candidates)
+        if (!is_relaxed[idx])
+        {
+            const auto& cp_var = probdata.cp_bool_vars_[idx];
+            if (!cp.assume(probdata.sol_.bool_vars_sol_[idx] ? cp_var : ~cp_var))
+            {
+                goto UPDATE_NEIGHBOURHOOD;
+            }
+        }
+
+    // Solve.
+    cp_result = cp.solve(limits{.time = time_remaining, .conflicts = MAX_LNS_CONFLICTS});
+    debugln("   Search: {}",
+            cp_result == geas::solver::SAT ? "SAT" : cp_result == geas::solver::UNSAT ? "UNSAT" : "UNKNOWN");
+    if (cp_result == geas::solver::SAT)
+    {
+        ++heurdata.nb_sat;
+        SCIP_CALL(add_cp_solution(scip, heur, probdata));
+        ++heurdata.nb_sols;
+        *result = SCIP_FOUNDSOL;
+    }
+
+    // Adapt the size of the neighbourhood.
+    UPDATE_NEIGHBOURHOOD:
+    if (cp_result == geas::solver::UNSAT)
+    {
+        ++heurdata.nb_unsat;
+        heurdata.relax_fraction = std::min(heurdata.relax_fraction * RELAX_FRACTION_FACTOR, MAX_RELAX_FRACTION);
+    }
+    else if (cp_result == geas::solver::UNKNOWN)
+    {
+        ++heurdata.nb_unknown;
+        heurdata.relax_fraction = std::max(heurdata.relax_fraction / RELAX_FRACTION_FACTOR, MIN_RELAX_FRACTION);
+    }
+
+    // Done.
+    EXIT:
+    cp.clear_assumptions();
+    heurdata.run_time += SCIPgetSolvingTime(scip) - start_time;
+    return SCIP_OKAY;
+}
+
+// Initialization method of primal heuristic (called after problem was transformed)
+static
+SCIP_DECL_HEURINIT(heurInitCPLNS)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(heur);
+
+    // Reset statistics and create random number generator.
+    auto& heurdata = *reinterpret_cast<HeurCPLNSData*>(SCIPheurGetData(heur));
+    heurdata = HeurCPLNSData{};
+    heurdata.relax_fraction = INIT_RELAX_FRACTION;
+    SCIP_CALL(SCIPcreateRandom(scip, &heurdata.randnumgen, DEFAULT_RANDSEED, TRUE));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Deinitialization method of primal heuristic (called before transformed problem is freed)
+static
+SCIP_DECL_HEUREXIT(heurExitCPLNS)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(heur);
+
+    // Free random number generator.
+    auto& heurdata = *reinterpret_cast<HeurCPLNSData*>(SCIPheurGetData(heur));
+    SCIPfreeRandom(scip, &heurdata.randnumgen);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Destructor of primal heuristic
+static
+SCIP_DECL_HEURFREE(heurFreeCPLNS)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(heur);
+
+    // Free heuristic data.
+    delete reinterpret_cast<HeurCPLNSData*>(SCIPheurGetData(heur));
+    SCIPheurSetData(heur, nullptr);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Output method of statistics table
+static
+SCIP_DECL_TABLEOUTPUT(tableOutputCPLNS)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(table);
+
+    // Print statistics.
+    const auto& heurdata = *reinterpret_cast<HeurCPLNSData*>(SCIPtableGetData(table));
+    SCIPinfoMessage(scip, file, "CP LNS             :      Calls        SAT      UNSAT    Unknown  Solutions   Relax(%%)       Time\n");
+    SCIPinfoMessage(scip, file, "  %-17s: %10lld %10lld %10lld %10lld %10lld %10.1f %10.2f\n",
+                    HEUR_NAME,
+                    static_cast<long long>(heurdata.nb_calls),
+                    static_cast<long long>(heurdata.nb_sat),
+                    static_cast<long long>(heurdata.nb_unsat),
+                    static_cast<long long>(heurdata.nb_unknown),
+                    static_cast<long long>(heurdata.nb_sols),
+                    100.0 * heurdata.relax_fraction,
+                    heurdata.run_time);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Include primal heuristic that improves the incumbent by large neighbourhood search in the CP solver
+SCIP_RETCODE includeHeurCPLNS(SCIP* scip)
+{
+    // Create heuristic data.
+    auto heurdata = new HeurCPLNSData{};
+
+    // Create primal heuristic.
+    SCIP_HEUR* heur = nullptr;
+    SCIP_CALL(SCIPincludeHeurBasic(scip,
+                                   &heur,
+                                   HEUR_NAME,
+                                   HEUR_DESC,
+                                   HEUR_DISPCHAR,
+                                   HEUR_PRIORITY,
+                                   HEUR_FREQ,
+                                   HEUR_FREQOFS,
+                                   HEUR_MAXDEPTH,
+                                   HEUR_TIMING,
+                                   HEUR_USESSUBSCIP,
+                                   heurExecCPLNS,
+                                   reinterpret_cast<SCIP_HEURDATA*>(heurdata)));
+    debug_assert(heur);
+    SCIP_CALL(SCIPsetHeurInit(scip, heur, heurInitCPLNS));
+    SCIP_CALL(SCIPsetHeurExit(scip, heur, heurExitCPLNS));
+    SCIP_CALL(SCIPsetHeurFree(scip, heur, heurFreeCPLNS));
+
+    // Create statistics table.
+    SCIP_CALL(SCIPincludeTable(scip,
+                               TABLE_NAME,
+                               TABLE_DESC,
+                               TRUE,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               tableOutputCPLNS,
+                               reinterpret_cast<SCIP_TABLEDATA*>(heurdata),
+                               TABLE_POSITION,
+                               TABLE_EARLIEST_STAGE));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+}
@@ -0,0 +1,15 @@
+#ifndef NUTMEG_HEURISTIC_CPLNS_H
+#define NUTMEG_HEURISTIC_CPLNS_H
+
+#include "Includes.h"
+#include "ProblemData.h"
+
+namespace Nutmeg
+{
+
+// Include primal heuristic that improves the incumbent by large neighbourhood search in the CP solver
+SCIP_RETCODE includeHeurCPLNS(SCIP* scip);
+
+}
+
+#endif
@@ -0,0 +1,360 @@
+//#define PRINT_DEBUG
+
+#include "Heuristic-CPRounding.h"
+#include "ConstraintHandler-Geas.h"
+#include <algorithm>
+#include <cmath>
+
+#define HEUR_NAME                        "cprounding"
+#define HEUR_DESC   "CP search guided by the LP solution"
+#define HEUR_DISPCHAR                            'g' // display character of the primal heuristic
+#define HEUR_PRIORITY                        -1000100 // priority of the primal heuristic
+#define HEUR_FREQ                                  10 // frequency for calling the primal heuristic
+#define HEUR_FREQOFS                                0 // frequency offset for calling the primal heuristic
+#define HEUR_MAXDEPTH                              -1 // maximal depth level to call the primal heuristic
+#define HEUR_TIMING        SCIP_HEURTIMING_AFTERLPNODE // timing of the primal heuristic
+#define HEUR_USESSUBSCIP                        FALSE // does the primal heuristic use a secondary SCIP instance?
+
+#define TABLE_NAME                       "cprounding"
+#define TABLE_DESC   "statistics of the CP rounding heuristic"
+#define TABLE_POSITION                          12500 // position of the statistics table
+#define TABLE_EARLIEST_STAGE      SCIP_STAGE_SOLVING // output of the statistics table is only printed from this stage onwards
+
+#define MAX_HEUR_DURATION                         0.5 // maximum run time of one call
+#define MAX_HEUR_CONFLICTS                       1000 // maximum number of conflicts in one CP search
+#define MAX_HEUR_SEARCHES                           4 // maximum number of CP searches in one call
+#define HINT_CONFIDENCE                           1.0 // confidence of values hinted by the user, above any rounding
+
+namespace Nutmeg
+{
+
+struct HeurCPRoundingData
+{
+    Int nb_calls;
+    Int nb_searches;
+    Int nb_sat;
+    Int nb_unsat;
+    Int nb_unknown;
+    Int nb_sols;
+    Float run_time;
+};
+
+// Rounded value of a variable in the LP solution
+struct Preference
+{
+    Int idx;
+    bool is_int;
+    Int val;
+    Float confidence;
+};
+
+static inline
+Float get_time_remaining(
+    SCIP* scip    // SCIP
+)
+{
+    SCIP_Real time_limit;
+    scip_assert(SCIPgetRealParam(scip, "limits/time", &time_limit));
+    return time_limit - SCIPgetSolvingTime(scip);
+}
+
+// Round the LP solution, ordered by decreasing distance of the LP value from rounding the other way.
+// Values hinted by the user replace the rounding and come first.
+static
+Vector<Preference> get_preferences(
+    SCIP* scip,               // SCIP
+    ProblemData& probdata     // Problem data
+)
+{
+    // Get hints on positive Boolean variables and on integer variables other than the objective.
+    Vector<Int> bool_vars_hint(probdata.nb_bool_vars(), -1);
+    for (const auto& [idx, val] : probdata.bool_vars_hint_)
+    {
+        const auto pos_idx = probdata.is_pos_var(idx) ? idx : probdata.mip_neg_vars_idx_[idx];
+        bool_vars_hint[pos_idx] = pos_idx == idx ? val : !val;
+    }
+    HashTable<Int, Int> int_vars_hint;
+    for (const auto& [idx, val] : probdata.int_vars_hint_)
+        if (idx != probdata.obj_var_idx_)
+        {
+            int_vars_hint[idx] = val;
+        }
+
+    // Get preferences.
+    Vector<Preference> preferences;
+    for (Int idx = 2; idx < probdata.nb_bool_vars(); ++idx)
+        if (probdata.is_pos_var(idx))
+        {
+            if (bool_vars_hint[idx] >= 0)
+            {
+                preferences.push_back({idx, false, bool_vars_hint[idx], HINT_CONFIDENCE});
+            }
+            else
+            {
+                const auto val = SCIPgetSolVal(scip, nullptr, probdata.mip_bool_vars_[idx]);
+                preferences.push_back({idx, false, val >= 0.5, std::abs(val - 0.5)});
+            }
+        }
+    for (Int idx = 1; idx < probdata.nb_int_vars(); ++idx)
+        if (auto it = int_vars_hint.find(idx); it != int_vars_hint.end())
+        {
+            preferences.push_back({idx, true, it->second, HINT_CONFIDENCE});
+        }
+        else if (const auto mip_var = probdata.mip_int_vars_[idx]; mip_var && idx != probdata.obj_var_idx_)
+        {
+            const auto val = SCIPgetSolVal(scip, nullptr, mip_var);
+            const auto rounded_val = SCIPround(scip, val);
+            preferences.push_back({idx, true, static_cast<Int>(rounded_val), 0.5 - std::abs(val - rounded_val)});
+        }
+    std::stable_sort(preferences.begin(),
+                     preferences.end(),
+                     [](const Preference& a, const Preference& b) { return a.confidence > b.confidence; });
+    return preferences;
+}
+
+// Assume a rounded value in the CP solver
+static inline
+bool assume_preference(
+    ProblemData& probdata,              // Problem data
+    const Preference& preference        // Rounded value
+)
+{
+    auto& cp = probdata.cp_;
+    if (preference.is_int)
+    {
+        const auto& cp_var = probdata.cp_int_vars_[preference.idx];
+        return cp.assume(cp_var >= preference.val) && cp.assume(cp_var <= preference.val);
+    }
+    else
+    {
+        const auto& cp_var = probdata.cp_bool_vars_[preference.idx];
+        return cp.assume(preference.val ? cp_var : ~cp_var);
+    }
+}
+
+// Execution method of primal heuristic. The rounded LP solution is assumed in order of confidence until
+// an assumption fails, and the CP solver searches for a solution from there. If the search fails, it is
+// restarted with half as many assumptions.
+static
+SCIP_DECL_HEUREXEC(heurExecCPRounding)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(heur);
+    debug_assert(strcmp(SCIPheurGetName(heur), HEUR_NAME) == 0);
+    debug_assert(result);
+    *result = SCIP_DIDNOTRUN;
+
+    // Only run on optimal LP solutions.
+    if (!SCIPhasCurrentNodeLP(scip) || SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL)
+    {
+        return SCIP_OKAY;
+    }
+
+    // Get problem data.
+    auto& probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(scip));
+    auto& cp = probdata.cp_;
+    auto& heurdata = *reinterpret_cast<HeurCPRoundingData*>(SCIPheurGetData(heur));
+    const auto& cp_obj_var = probdata.cp_int_vars_[probdata.obj_var_idx_];
+    const auto incumbent_obj = probdata.sol_.int_vars_sol_[probdata.obj_var_idx_];
+    const auto start_time = SCIPgetSolvingTime(scip);
+    debugln("Starting CP rounding heuristic at node {}", SCIPnodeGetNumber(SCIPgetCurrentNode(scip)));
+    ++heurdata.nb_calls;
+    *result = SCIP_DIDNOTFIND;
+
+    // Only search for improving solutions.
+    const auto assume_obj = [&]()
+    {
+        return incumbent_obj == std::numeric_limits<Int>::max() || cp.assume(cp_obj_var <= incumbent_obj - 1);
+    };
+
+    // Find the longest prefix of the rounded values that propagates without failure.
+    const auto preferences = get_preferences(scip, probdata);
+    Int nb_assumed = 0;
+    cp.clear_assumptions();
+    if (assume_obj())
+    {
+        while (nb_assumed < static_cast<Int>(preferences.size()) &&
+               assume_preference(probdata, preferences[nb_assumed]))
+        {
+            ++nb_assumed;
+        }
+    }
+    else
+    {
+        nb_assumed = -1;
+    }
+
+    // Search.
+    for (Int search = 0; search < MAX_HEUR_SEARCHES && nb_assumed >= 0; ++search)
+    {
+        // Get time remaining.
+        const auto time_remaining = std::min(MAX_HEUR_DURATION - (SCIPgetSolvingTime(scip) - start_time),
+                                             get_time_remaining(scip));
+        if (time_remaining <= 0)
+        {
+            break;
+        }
+
+        // Make assumptions. Clauses learned in earlier searches can make the prefix fail, in which case
+        // it is shortened.
+        cp.clear_assumptions();
+        if (!assume_obj())
+        {
+            break;
+        }
+        Int idx = 0;
+        while (idx < nb_assumed && assume_preference(probdata, preferences[idx]))
+        {
+            ++idx;
+        }
+        if (idx < nb_assumed)
+        {
+            nb_assumed = idx;
+            continue;
+        }
+
+        // Solve.
+        ++heurdata.nb_searches;
+        const auto cp_result = cp.solve(limits{.time = time_remaining, .conflicts = MAX_HEUR_CONFLICTS});
+        debugln("   Search with {} of {} rounded values: {}",
+                nb_assumed,
+                preferences.size(),
+                cp_result == geas::solver::SAT ? "SAT" : cp_result == geas::solver::UNSAT ? "UNSAT" : "UNKNOWN");
+        if (cp_result == geas::solver::SAT)
+        {
+            ++heurdata.nb_sat;
+            if (cp_obj_var.lb(cp.data) < probdata.sol_.int_vars_sol_[probdata.obj_var_idx_])
+            {
+                SCIP_CALL(add_cp_solution(scip, heur, probdata));
+                ++heurdata.nb_sols;
+                *result = SCIP_FOUNDSOL;
+            }
+            break;
+        }
+        else if (cp_result == geas::solver::UNSAT)
+        {
+            ++heurdata.nb_unsat;
+            if (nb_assumed == 0)
+            {
+                break;
+            }
+        }
+        else
+        {
+            ++heurdata.nb_unknown;
+        }
+
+        // Relax the rounding.
+        nb_assumed /= 2;
+    }
+    cp.clear_assumptions();
+
+    // Done.
+    heurdata.run_time += SCIPgetSolvingTime(scip) - start_time;
+    return SCIP_OKAY;
+}
+
+// Initialization method of primal heuristic (called after problem was transformed)
+static
+SCIP_DECL_HEURINIT(heurInitCPRounding)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(heur);
+
+    // Reset statistics.
+    auto& heurdata = *reinterpret_cast<HeurCPRoundingData*>(SCIPheurGetData(heur));
+    heurdata = HeurCPRoundingData{};
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Destructor of primal heuristic
+static
+SCIP_DECL_HEURFREE(heurFreeCPRounding)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(heur);
+
+    // Free heuristic data.
+    delete reinterpret_cast<HeurCPRoundingData*>(SCIPheurGetData(heur));
+    SCIPheurSetData(heur, nullptr);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Output method of statistics table
+static
+SCIP_DECL_TABLEOUTPUT(tableOutputCPRounding)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(table);
+
+    // Print statistics.
+    const auto& heurdata = *reinterpret_cast<HeurCPRoundingData*>(SCIPtableGetData(table));
+    SCIPinfoMessage(scip, file, "CP rounding        :      Calls   Searches        SAT      UNSAT    Unknown  Solutions       Time\n");
+    SCIPinfoMessage(scip, file, "  %-17s: %10lld %10lld %10lld %10lld %10lld %10lld %10.2f\n",
+                    HEUR_NAME,
+                    static_cast<long long>(heurdata.nb_calls),
+                    static_cast<long long>(heurdata.nb_searches),
+                    static_cast<long long>(heurdata.nb_sat),
+                    static_cast<long long>(heurdata.nb_unsat),
+                    static_cast<long long>(heurdata.nb_unknown),
+                    static_cast<long long>(heurdata.nb_sols),
+                    heurdata.run_time);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Include primal heuristic that completes a rounding of the LP solution in the CP solver
+SCIP_RETCODE includeHeurCPRounding(SCIP* scip)
+{
+    // Create heuristic data.
+    auto heurdata = new HeurCPRoundingData{};
+
+    // Create primal heuristic.
+    SCIP_HEUR* heur = nullptr;
+    SCIP_CALL(SCIPincludeHeurBasic(scip,
+                                   &heur,
+                                   HEUR_NAME,
+                                   HEUR_DESC,
+                                   HEUR_DISPCHAR,
+                                   HEUR_PRIORITY,
+                                   HEUR_FREQ,
+                                   HEUR_FREQOFS,
+                                   HEUR_MAXDEPTH,
+                                   HEUR_TIMING,
+                                   HEUR_USESSUBSCIP,
+                                   heurExecCPRounding,
+                                   reinterpret_cast<SCIP_HEURDATA*>(heurdata)));
+    debug_assert(heur);
+    SCIP_CALL(SCIPsetHeurInit(scip, heur, heurInitCPRounding));
+    SCIP_CALL(SCIPsetHeurFree(scip, heur, heurFreeCPRounding));
+
+    // Create statistics table.
+    SCIP_CALL(SCIPincludeTable(scip,
+                               TABLE_NAME,
+                               TABLE_DESC,
+                               TRUE,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               tableOutputCPRounding,
+                               reinterpret_cast<SCIP_TABLEDATA*>(heurdata),
+                               TABLE_POSITION,
+                               TABLE_EARLIEST_STAGE));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+}
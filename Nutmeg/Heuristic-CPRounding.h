@@ -0,0 +1,15 @@
+#ifndef NUTMEG_HEURISTIC_CPROUNDING_H
+#define NUTMEG_HEURISTIC_CPROUNDING_H
+
+#include "Includes.h"
+#include "ProblemData.h"
+
+namespace Nutmeg
+{
+
+// Include primal heuristic that completes a rounding of the LP solution in the CP solver
+SCIP_RETCODE includeHeurCPRounding(SCIP* scip);
+
+}
+
+#endif
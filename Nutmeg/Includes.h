@@ -4,6 +4,7 @@
 #include "Debug.h"
 
 #include <vector>
+#include <array>
 #include <unordered_map>
 #include <string>
 #include <utility>
@@ -20,6 +21,9 @@ using Float = SCIP_Real;
 template<class T>
 using Vector = std::vector<T>;
 
+template<class T, std::size_t N>
+using Array = std::array<T, N>;
+
 template<class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
 using HashTable = std::unordered_map<Key, T, Hash, KeyEqual>;
 
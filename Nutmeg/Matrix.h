@@ -1,22 +1,162 @@
 #ifndef NUTMEG_MATRIX_H
 #define NUTMEG_MATRIX_H
 
-#include <valarray>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
 
+// Fixed-size array aligned to a cache line. Unlike std::vector, bool elements are stored as bytes so
+// references to them can be taken.
+template<typename T>
+class AlignedArray
+{
+    T* _data{nullptr};
+    size_t _size{0};
+
+  public:
+    static constexpr size_t alignment = alignof(T) > 64 ? alignof(T) : 64;
+
+    // Constructors and destructors
+    AlignedArray(const size_t size, const T& value)
+        : _data(allocate(size)),
+          _size(size)
+    {
+        std::uninitialized_fill_n(_data, _size, value);
+    }
+    AlignedArray() = default;
+    AlignedArray(const AlignedArray<T>& other)
+        : _data(allocate(other._size)),
+          _size(other._size)
+    {
+        std::uninitialized_copy_n(other._data, _size, _data);
+    }
+    AlignedArray(AlignedArray<T>&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0))
+    {
+    }
+    ~AlignedArray() { release(); }
+
+    // Assignment
+    AlignedArray<T>& operator=(const AlignedArray<T>& other)
+    {
+        if (this != &other)
+        {
+            AlignedArray<T> copy(other);
+            std::swap(_data, copy._data);
+            std::swap(_size, copy._size);
+        }
+        return *this;
+    }
+    AlignedArray<T>& operator=(AlignedArray<T>&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+        }
+        return *this;
+    }
+
+    // Getters
+    inline size_t size() const { return _size; }
+    inline T* data() { return _data; }
+    inline const T* data() const { return _data; }
+    inline T& operator[](const size_t i) { return _data[i]; }
+    inline const T& operator[](const size_t i) const { return _data[i]; }
+    inline T* begin() { return _data; }
+    inline T* end() { return _data + _size; }
+    inline const T* begin() const { return _data; }
+    inline const T* end() const { return _data + _size; }
+
+  private:
+    static T* allocate(const size_t size)
+    {
+        if (size == 0)
+            return nullptr;
+        return static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t(alignment)));
+    }
+    void release()
+    {
+        if (_data)
+        {
+            std::destroy_n(_data, _size);
+            ::operator delete(_data, std::align_val_t(alignment));
+        }
+        _data = nullptr;
+        _size = 0;
+    }
+};
+
+// View of a row of a matrix
+template<typename T>
+class MatrixRow
+{
+    T* _data;
+    size_t _size;
+
+  public:
+    MatrixRow(T* data, const size_t size) : _data(data), _size(size) {}
+
+    inline size_t size() const { return _size; }
+    inline T* data() const { return _data; }
+    inline T& operator[](const size_t j) const { return _data[j]; }
+    inline T* begin() const { return _data; }
+    inline T* end() const { return _data + _size; }
+};
+
+// View of a column of a matrix
+template<typename T>
+class MatrixColumn
+{
+    T* _data;
+    size_t _size;
+    size_t _stride;
+
+  public:
+    class Iterator
+    {
+        T* _ptr;
+        size_t _stride;
+
+      public:
+        Iterator(T* ptr, const size_t stride) : _ptr(ptr), _stride(stride) {}
+        inline T& operator*() const { return *_ptr; }
+        inline Iterator& operator++() { _ptr += _stride; return *this; }
+        inline bool operator!=(const Iterator& other) const { return _ptr != other._ptr; }
+        inline bool operator==(const Iterator& other) const { return _ptr == other._ptr; }
+    };
+
+    MatrixColumn(T* data, const size_t size, const size_t stride) : _data(data), _size(size), _stride(stride) {}
+
+    inline size_t size() const { return _size; }
+    inline T& operator[](const size_t i) const { return _data[i * _stride]; }
+    inline Iterator begin() const { return Iterator(_data, _stride); }
+    inline Iterator end() const { return Iterator(_data + _size * _stride, _stride); }
+};
+
+// Dense row-major matrix in contiguous storage aligned to a cache line
 template<typename T>
 class Matrix
 {
   protected:
     size_t _rows{0};
     size_t _cols{0};
-    std::valarray<T> _data{};
+    AlignedArray<T> _data{};
 
   public:
     // Constructors and destructors
     Matrix(const size_t rows, const size_t cols, const T value = {})
         : _rows(rows),
           _cols(cols),
-          _data(value, rows * cols)
+          _data(rows * cols, value)
     {
     }
     Matrix(const size_t rows, const size_t cols, const T* const* matrix)
@@ -36,7 +176,7 @@ class Matrix
     Matrix<T>& operator=(Matrix<T>&& other) = default;
     Matrix<T>& operator=(const T& value)
     {
-        _data = value;
+        std::fill(_data.begin(), _data.end(), value);
         return *this;
     }
 
@@ -45,19 +185,23 @@ class Matrix
     {
         _rows = rows;
         _cols = cols;
-        _data.resize(0);
-        _data.resize(rows * cols, value);
+        _data = AlignedArray<T>();
+        _data = AlignedArray<T>(rows * cols, value);
     }
 
     // Comparison
     inline bool operator==(const Matrix<T>& other) const
     {
-        return _rows == other.rows() && _data == other._data;
+        return _rows == other.rows() &&
+               _cols == other.cols() &&
+               std::equal(_data.begin(), _data.end(), other._data.begin());
     }
 
     // Getters
     inline size_t rows() const { return _rows; }
     inline size_t cols() const { return _cols; }
+    inline T* data() { return _data.data(); }
+    inline const T* data() const { return _data.data(); }
     inline const T operator()(const size_t i, const size_t j) const
     {
 #ifndef NDEBUG
@@ -84,12 +228,83 @@ class Matrix
     }
 
     // Row iterators
-    inline auto begin(const size_t row) { return (&_data[0]) + (row * cols()); }
-    inline auto end(const size_t row) { return (&_data[0]) + ((row + 1) * cols()); }
-    inline auto begin(const size_t row) const { return (&_data[0]) + (row * cols()); }
-    inline auto end(const size_t row) const { return (&_data[0]) + ((row + 1) * cols()); }
-    inline auto cbegin(const size_t row) const { return (&_data[0]) + (row * cols()); }
-    inline auto cend(const size_t row) const { return (&_data[0]) + ((row + 1) * cols()); }
+    inline auto begin(const size_t row) { return data() + (row * cols()); }
+    inline auto end(const size_t row) { return data() + ((row + 1) * cols()); }
+    inline auto begin(const size_t row) const { return data() + (row * cols()); }
+    inline auto end(const size_t row) const { return data() + ((row + 1) * cols()); }
+    inline auto cbegin(const size_t row) const { return data() + (row * cols()); }
+    inline auto cend(const size_t row) const { return data() + ((row + 1) * cols()); }
+
+    // Row and column views
+    inline MatrixRow<T> row(const size_t i) { check_row(i); return MatrixRow<T>(begin(i), cols()); }
+    inline MatrixRow<const T> row(const size_t i) const { check_row(i); return MatrixRow<const T>(begin(i), cols()); }
+    inline MatrixColumn<T> col(const size_t j) { check_col(j); return MatrixColumn<T>(data() + j, rows(), cols()); }
+    inline MatrixColumn<const T> col(const size_t j) const { check_col(j); return MatrixColumn<const T>(data() + j, rows(), cols()); }
+
+    // Row operations for numeric types. The loops run over contiguous memory without branches so the
+    // compiler can vectorize them.
+    void fill_row(const size_t i, const T value)
+    {
+        static_assert(std::is_arithmetic_v<T>, "Row operations need a numeric type");
+        check_row(i);
+        T* __restrict row_data = begin(i);
+        for (size_t j = 0; j < _cols; ++j)
+            row_data[j] = value;
+    }
+    // row[dst] += scale * row[src]
+    void add_row(const size_t dst, const size_t src, const T scale = 1)
+    {
+        static_assert(std::is_arithmetic_v<T>, "Row operations need a numeric type");
+        check_row(dst);
+        check_row(src);
+        if (dst == src)
+        {
+            scale_row(dst, scale + 1);
+            return;
+        }
+        T* __restrict dst_data = begin(dst);
+        const T* __restrict src_data = begin(src);
+        for (size_t j = 0; j < _cols; ++j)
+            dst_data[j] += scale * src_data[j];
+    }
+    void scale_row(const size_t i, const T scale)
+    {
+        static_assert(std::is_arithmetic_v<T>, "Row operations need a numeric type");
+        check_row(i);
+        T* __restrict row_data = begin(i);
+        for (size_t j = 0; j < _cols; ++j)
+            row_data[j] *= scale;
+    }
+    T row_sum(const size_t i) const
+    {
+        static_assert(std::is_arithmetic_v<T>, "Row operations need a numeric type");
+        check_row(i);
+        const T* __restrict row_data = begin(i);
+        T sum = 0;
+        for (size_t j = 0; j < _cols; ++j)
+            sum += row_data[j];
+        return sum;
+    }
+    T row_min(const size_t i) const
+    {
+        static_assert(std::is_arithmetic_v<T>, "Row operations need a numeric type");
+        check_row(i);
+        const T* __restrict row_data = begin(i);
+        T min = std::numeric_limits<T>::max();
+        for (size_t j = 0; j < _cols; ++j)
+            min = row_data[j] < min ? row_data[j] : min;
+        return min;
+    }
+    T row_max(const size_t i) const
+    {
+        static_assert(std::is_arithmetic_v<T>, "Row operations need a numeric type");
+        check_row(i);
+        const T* __restrict row_data = begin(i);
+        T max = std::numeric_limits<T>::lowest();
+        for (size_t j = 0; j < _cols; ++j)
+            max = row_data[j] > max ? row_data[j] : max;
+        return max;
+    }
 
     // Print
     inline void print() const
@@ -102,6 +317,32 @@ class Matrix
     }
 
   private:
+    // Bounds checks
+    inline void check_row(const size_t i) const
+    {
+#ifndef NDEBUG
+        if (i >= rows())
+        {
+            printf("Accessing matrix row %lu is out of bounds\n", i);
+            std::abort();
+        }
+#else
+        (void)i;
+#endif
+    }
+    inline void check_col(const size_t j) const
+    {
+#ifndef NDEBUG
+        if (j >= cols())
+        {
+            printf("Accessing matrix column %lu is out of bounds\n", j);
+            std::abort();
+        }
+#else
+        (void)j;
+#endif
+    }
+
     // Internal print methods
     template<class U>
     static inline void print_internal(const Matrix<U>&)
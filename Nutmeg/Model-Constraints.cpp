@@ -2,23 +2,49 @@
 
 #include "Model.h"
 #include "Variable.h"
+#include "Separator-AllDifferent.h"
 #include "scip/cons_linear.h"
 #include "scip/cons_setppc.h"
 #include "scip/cons_indicator.h"
+#include "scip/cons_orbitope.h"
+#include <algorithm>
+
+// Minimum array length for separating the convex hull of element constraints lazily
+#define LAZY_ELEMENT_MIN_SIZE 50
 
 #define geas_add_constr(expr) if (!expr) { status_ = Status::Infeasible; return false; }
 
 namespace Nutmeg
 {
 
+// Record the variables of a constraint in the CP subproblem for splitting it into components
+void Model::add_cp_scope(const Vector<BoolVar>& bool_vars, const Vector<IntVar>& int_vars)
+{
+    CpScope scope;
+    for (const auto var : bool_vars)
+        if (var.is_valid())
+        {
+            scope.bool_vars_idx.push_back(var.idx);
+        }
+    for (const auto var : int_vars)
+        if (var.is_valid())
+        {
+            scope.int_vars_idx.push_back(var.idx);
+        }
+    probdata_->cp_scopes_.push_back(std::move(scope));
+}
+
 bool Model::add_constr_fix(const BoolVar var)
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Fix variable in MIP.
     {
         const auto var_idx = var.idx;
-        const auto neg_idx = probdata_.mip_neg_vars_idx_[var_idx];
+        const auto neg_idx = probdata_->mip_neg_vars_idx_[var_idx];
         const auto var_is_pos = is_pos_var(var);
-        auto mip_var = var_is_pos ? probdata_.mip_bool_vars_[var_idx] : probdata_.mip_bool_vars_[neg_idx];
+        auto mip_var = var_is_pos ? probdata_->mip_bool_vars_[var_idx] : probdata_->mip_bool_vars_[neg_idx];
 
         SCIP_Bool infeasible = FALSE;
         SCIP_Bool fixed = FALSE;
@@ -32,7 +58,58 @@ bool Model::add_constr_fix(const BoolVar var)
     }
 
     // Fix variable in CP.
-    geas_add_constr(cp_.post(cp_var(var)));
+    geas_add_constr(cp_->post(cp_var(var)));
+
+    // Success.
+    return true;
+}
+
+bool Model::add_constr_bounds(const IntVar var, const Int new_lb, const Int new_ub)
+{
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
+    // Check.
+    release_assert(var.model == this, "Variable belongs to a different model");
+    release_assert(0 <= var.idx && var.idx < nb_int_vars(), "Variable is invalid");
+    if (new_lb > new_ub)
+    {
+        status_ = Status::Infeasible;
+        return false;
+    }
+
+    // Tighten bounds in MIP.
+    if (auto mip_var = this->mip_var(var); mip_var)
+    {
+        const auto mip_lb = std::max<SCIP_Real>(new_lb, SCIPvarGetLbOriginal(mip_var));
+        const auto mip_ub = std::min<SCIP_Real>(new_ub, SCIPvarGetUbOriginal(mip_var));
+        if (mip_lb > mip_ub)
+        {
+            status_ = Status::Infeasible;
+            return false;
+        }
+        scip_assert(SCIPchgVarLb(mip_, mip_var, mip_lb));
+        scip_assert(SCIPchgVarUb(mip_, mip_var, mip_ub));
+    }
+
+    // Fix the indicator variables of removed values to false.
+    if (has_mip_indicator_vars(var))
+    {
+        const auto& indicator_vars_idx = probdata_->mip_indicator_vars_idx_[var.idx];
+        for (Int val = lb(var); val <= ub(var); ++val)
+            if (const auto indicator_var_idx = indicator_vars_idx[val - lb(var)];
+                (val < new_lb || val > new_ub) && indicator_var_idx >= 2)
+            {
+                if (!add_constr_fix(~BoolVar(this, indicator_var_idx)))
+                {
+                    return false;
+                }
+            }
+    }
+
+    // Tighten bounds in CP.
+    geas_add_constr(cp_->post(cp_var(var) >= new_lb));
+    geas_add_constr(cp_->post(cp_var(var) <= new_ub));
 
     // Success.
     return true;
@@ -45,6 +122,9 @@ bool Model::add_constr_linear(
     const Int rhs
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(vars.size() == coeffs.size(),
                    "Vectors of variables and coefficients have different lengths in "
@@ -90,6 +170,7 @@ bool Model::add_constr_linear(
 
     // Create constraint in CP.
     CREATE_CP_CONSTRAINT:
+    add_cp_scope({}, vars);
     {
         if (vars.size() == 2 && ((coeffs[0] == 1 && coeffs[1] == -1) || (coeffs[0] == -1 && coeffs[1] == 1)))
         {
@@ -102,21 +183,21 @@ bool Model::add_constr_linear(
                 // x - y >= rhs
                 // y - x <= -rhs
                 // y <= x - rhs
-                geas_add_constr(geas::int_le(cp_.data, y, x, -rhs));
+                geas_add_constr(geas::int_le(cp_->data, y, x, -rhs));
                 goto EXIT;
             }
             else if (sign == Sign::LE)
             {
                 // x - y <= rhs
                 // x <= y + rhs
-                geas_add_constr(geas::int_le(cp_.data, x, y, rhs));
+                geas_add_constr(geas::int_le(cp_->data, x, y, rhs));
                 goto EXIT;
             }
             else if (sign == Sign::EQ && rhs == 0)
             {
                 // x - y == 0
                 // x == y
-                geas_add_constr(geas::int_eq(cp_.data, x, y));
+                geas_add_constr(geas::int_eq(cp_->data, x, y));
                 goto EXIT;
             }
         }
@@ -131,7 +212,7 @@ bool Model::add_constr_linear(
             }
             if (sign != Sign::GE)
             {
-                geas_add_constr(geas::linear_le(cp_.data, cp_coeffs, cp_vars, rhs));
+                geas_add_constr(geas::linear_le(cp_->data, cp_coeffs, cp_vars, rhs));
             }
             if (sign != Sign::LE)
             {
@@ -139,7 +220,7 @@ bool Model::add_constr_linear(
                 {
                     coeff *= -1;
                 }
-                geas_add_constr(geas::linear_le(cp_.data, cp_coeffs, cp_vars, -rhs));
+                geas_add_constr(geas::linear_le(cp_->data, cp_coeffs, cp_vars, -rhs));
             }
         }
     }
@@ -155,6 +236,9 @@ bool Model::add_constr_linear_neq(
     const Int rhs
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(vars.size() == coeffs.size(),
                    "Vectors of variables and coefficients have different lengths in "
@@ -236,6 +320,7 @@ bool Model::add_constr_linear_neq(
 
     // Create constraint in CP.
     CREATE_CP_CONSTRAINT:
+    add_cp_scope({}, vars);
     {
         const Int size = vars.size();
         vec<geas::intvar> cp_vars(size);
@@ -245,15 +330,59 @@ bool Model::add_constr_linear_neq(
             cp_vars[idx] = cp_var(vars[idx]);
             cp_coeffs[idx] = coeffs[idx];
         }
-        geas_add_constr(geas::linear_ne(cp_.data, cp_coeffs, cp_vars, rhs));
+        geas_add_constr(geas::linear_ne(cp_->data, cp_coeffs, cp_vars, rhs));
     }
 
     // Success.
     return true;
 }
 
-bool Model::add_constr_element(const IntVar& idx_var, const Vector<Int>& array, const IntVar& val_var)
+// Add a linear constraint to the MIP. A lazy constraint stays out of the initial LP and is only
+// separated when violated.
+static void add_mip_linear_row(
+    SCIP* mip,
+    const Vector<SCIP_VAR*>& vars,
+    const Vector<Float>& coeffs,
+    const Float lhs,
+    const Float rhs,
+    const bool lazy
+)
+{
+    debug_assert(vars.size() == coeffs.size());
+    SCIP_CONS* cons = nullptr;
+    scip_assert(SCIPcreateConsLinear(mip,
+                                     &cons,
+                                     "",
+                                     vars.size(),
+                                     const_cast<SCIP_VAR**>(vars.data()),
+                                     const_cast<Float*>(coeffs.data()),
+                                     lhs,
+                                     rhs,
+                                     !lazy,
+                                     TRUE,
+                                     TRUE,
+                                     TRUE,
+                                     TRUE,
+                                     FALSE,
+                                     FALSE,
+                                     lazy,
+                                     lazy,
+                                     FALSE));
+    debug_assert(cons);
+    scip_assert(SCIPaddCons(mip, cons));
+    scip_assert(SCIPreleaseCons(mip, &cons));
+}
+
+bool Model::add_constr_element(
+    const IntVar& idx_var,
+    const Vector<Int>& array,
+    const IntVar& val_var,
+    const ElementFormulation formulation
+)
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Create constraint in MIP.
     if (mip_var(idx_var) && mip_var(val_var))
     {
@@ -298,54 +427,73 @@ bool Model::add_constr_element(const IntVar& idx_var, const Vector<Int>& array,
                 return false;
             }
         }
-        geas_add_constr(cp_.post(cp_var(idx_var) >= 1));
-        geas_add_constr(cp_.post(cp_var(idx_var) <= size));
+        geas_add_constr(cp_->post(cp_var(idx_var) >= 1));
+        geas_add_constr(cp_->post(cp_var(idx_var) <= size));
 
-        // Create indicator constraints.
-        for (Int idx = std::max(1, lb(idx_var)); idx <= std::min(size, ub(idx_var)); ++idx)
+        // Create convex hull.
+        // val = sum(idx in array) (array[idx] * [idx_var == idx])
+        if (formulation == ElementFormulation::ConvexHull)
         {
-            // Get variables.
-            auto ind_var = mip_indicator_var(idx_var, idx);
-            release_assert(ind_var, "Indicator variable missing while creating element constraint");
-            auto mip_val_var = mip_var(val_var);
-
-            // Create constraint <=.
+            Vector<SCIP_VAR*> vars{mip_var(val_var)};
+            Vector<Float> coeffs{-1};
+            for (Int idx = std::max(1, lb(idx_var)); idx <= std::min(size, ub(idx_var)); ++idx)
             {
-                SCIP_CONS* cons;
-                Float coeff = 1;
-                Float rhs = array[idx - 1];
-                scip_assert(SCIPcreateConsBasicIndicator(mip_,
-                                                         &cons,
-                                                         "",
-                                                         ind_var,
-                                                         1,
-                                                         &mip_val_var,
-                                                         &coeff,
-                                                         rhs));
-                scip_assert(SCIPaddCons(mip_, cons));
-                scip_assert(SCIPreleaseCons(mip_, &cons));
+                auto ind_var = mip_indicator_var(idx_var, idx);
+                release_assert(ind_var, "Indicator variable missing while creating element constraint");
+                vars.push_back(ind_var);
+                coeffs.push_back(array[idx - 1]);
             }
-
-            // Create constraint >=.
+            add_mip_linear_row(mip_, vars, coeffs, 0, 0, false);
+        }
+        else
+        {
+            // Create indicator constraints.
+            for (Int idx = std::max(1, lb(idx_var)); idx <= std::min(size, ub(idx_var)); ++idx)
             {
-                SCIP_CONS* cons;
-                Float coeff = -1;
-                Float rhs = -array[idx - 1];
-                scip_assert(SCIPcreateConsBasicIndicator(mip_,
-                                                         &cons,
-                                                         "",
-                                                         ind_var,
-                                                         1,
-                                                         &mip_val_var,
-                                                         &coeff,
-                                                         rhs));
-                scip_assert(SCIPaddCons(mip_, cons));
-                scip_assert(SCIPreleaseCons(mip_, &cons));
+                // Get variables.
+                auto ind_var = mip_indicator_var(idx_var, idx);
+                release_assert(ind_var, "Indicator variable missing while creating element constraint");
+                auto mip_val_var = mip_var(val_var);
+
+                // Create constraint <=.
+                {
+                    SCIP_CONS* cons;
+                    Float coeff = 1;
+                    Float rhs = array[idx - 1];
+                    scip_assert(SCIPcreateConsBasicIndicator(mip_,
+                                                             &cons,
+                                                             "",
+                                                             ind_var,
+                                                             1,
+                                                             &mip_val_var,
+                                                             &coeff,
+                                                             rhs));
+                    scip_assert(SCIPaddCons(mip_, cons));
+                    scip_assert(SCIPreleaseCons(mip_, &cons));
+                }
+
+                // Create constraint >=.
+                {
+                    SCIP_CONS* cons;
+                    Float coeff = -1;
+                    Float rhs = -array[idx - 1];
+                    scip_assert(SCIPcreateConsBasicIndicator(mip_,
+                                                             &cons,
+                                                             "",
+                                                             ind_var,
+                                                             1,
+                                                             &mip_val_var,
+                                                             &coeff,
+                                                             rhs));
+                    scip_assert(SCIPaddCons(mip_, cons));
+                    scip_assert(SCIPreleaseCons(mip_, &cons));
+                }
             }
         }
     }
 
     // Create constraint in CP.
+    add_cp_scope({}, {idx_var, val_var});
     {
         const Int size = array.size();
         vec<int> cp_array(size);
@@ -353,15 +501,23 @@ bool Model::add_constr_element(const IntVar& idx_var, const Vector<Int>& array,
         {
             cp_array[idx] = array[idx];
         }
-        geas::int_element(cp_.data, cp_var(val_var), cp_var(idx_var), cp_array);
+        geas::int_element(cp_->data, cp_var(val_var), cp_var(idx_var), cp_array);
     }
 
     // Success.
     return true;
 }
 
-bool Model::add_constr_element(const IntVar& idx_var, const Vector<IntVar>& array, const IntVar& val_var)
+bool Model::add_constr_element(
+    const IntVar& idx_var,
+    const Vector<IntVar>& array,
+    const IntVar& val_var,
+    const ElementFormulation formulation
+)
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Create constraint in MIP.
     if (mip_var(idx_var) && mip_var(val_var))
     {
@@ -413,53 +569,117 @@ bool Model::add_constr_element(const IntVar& idx_var, const Vector<IntVar>& arra
                 return false;
             }
         }
-        geas_add_constr(cp_.post(cp_var(idx_var) >= 1));
-        geas_add_constr(cp_.post(cp_var(idx_var) <= size));
-
-        // Create indicator constraints.
-        for (Int idx = std::max(1, lb(idx_var)); idx <= std::min(size, ub(idx_var)); ++idx)
+        geas_add_constr(cp_->post(cp_var(idx_var) >= 1));
+        geas_add_constr(cp_->post(cp_var(idx_var) <= size));
+
+        // Create disaggregated convex hull. Every index has a copy z[idx] of its array variable that is
+        // zero unless the index is selected. Long arrays only add the bounds on the copies when the LP
+        // violates them.
+        // val = sum(idx in array) z[idx]
+        // lb(array[idx]) * y[idx] <= z[idx] <= ub(array[idx]) * y[idx]
+        // lb(array[idx]) * (1 - y[idx]) <= array[idx] - z[idx] <= ub(array[idx]) * (1 - y[idx])
+        if (formulation == ElementFormulation::ConvexHull)
         {
-            // Get variables.
-            auto ind_var = mip_indicator_var(idx_var, idx);
-            release_assert(ind_var, "Indicator variable missing while creating element constraint");
-            Vector<SCIP_VAR*> mip_vars{mip_var(val_var), mip_var(array[idx - 1])};
-
-            // Create constraint <=.
+            const auto lazy = size >= LAZY_ELEMENT_MIN_SIZE;
+            Vector<SCIP_VAR*> sum_vars{mip_var(val_var)};
+            Vector<Float> sum_coeffs{-1};
+            for (Int idx = std::max(1, lb(idx_var)); idx <= std::min(size, ub(idx_var)); ++idx)
             {
-                Vector<Float> coeffs{1, -1};
-                SCIP_CONS* cons;
-                scip_assert(SCIPcreateConsBasicIndicator(mip_,
-                                                         &cons,
-                                                         "",
-                                                         ind_var,
-                                                         2,
-                                                         mip_vars.data(),
-                                                         coeffs.data(),
-                                                         0));
-                scip_assert(SCIPaddCons(mip_, cons));
-                scip_assert(SCIPreleaseCons(mip_, &cons));
+                // Get variables.
+                auto ind_var = mip_indicator_var(idx_var, idx);
+                release_assert(ind_var, "Indicator variable missing while creating element constraint");
+                const auto& var = array[idx - 1];
+                auto mip_array_var = mip_var(var);
+                const Float var_lb = lb(var);
+                const Float var_ub = ub(var);
+
+                // Create copy of the array variable.
+                SCIP_VAR* copy_var = nullptr;
+                const auto copy_name = fmt::format("element_copy[{},{}]", name(var), idx);
+                scip_assert(SCIPcreateVarBasic(mip_,
+                                               &copy_var,
+                                               copy_name.c_str(),
+                                               std::min(0.0, var_lb),
+                                               std::max(0.0, var_ub),
+                                               0.0,
+                                               SCIP_VARTYPE_CONTINUOUS));
+                release_assert(copy_var, "Failed to create variable in MIP");
+                scip_assert(SCIPaddVar(mip_, copy_var));
+                sum_vars.push_back(copy_var);
+                sum_coeffs.push_back(1);
+
+                // Create bounds on the copy.
+                add_mip_linear_row(mip_, {copy_var, ind_var}, {1, -var_lb}, 0, SCIPinfinity(mip_), lazy);
+                add_mip_linear_row(mip_, {copy_var, ind_var}, {1, -var_ub}, -SCIPinfinity(mip_), 0, lazy);
+                add_mip_linear_row(mip_,
+                                   {mip_array_var, copy_var, ind_var},
+                                   {1, -1, var_lb},
+                                   var_lb,
+                                   SCIPinfinity(mip_),
+                                   lazy);
+                add_mip_linear_row(mip_,
+                                   {mip_array_var, copy_var, ind_var},
+                                   {1, -1, var_ub},
+                                   -SCIPinfinity(mip_),
+                                   var_ub,
+                                   lazy);
+                scip_assert(SCIPreleaseVar(mip_, &copy_var));
             }
-
-            // Create constraint >=.
+            add_mip_linear_row(mip_, sum_vars, sum_coeffs, 0, 0, false);
+        }
+        else
+        {
+            // Create indicator constraints.
+            for (Int idx = std::max(1, lb(idx_var)); idx <= std::min(size, ub(idx_var)); ++idx)
             {
-                Vector<Float> coeffs{-1, 1};
-                SCIP_CONS* cons;
-                scip_assert(SCIPcreateConsBasicIndicator(mip_,
-                                                         &cons,
-                                                         "",
-                                                         ind_var,
-                                                         2,
-                                                         mip_vars.data(),
-                                                         coeffs.data(),
-                                                         0));
-                scip_assert(SCIPaddCons(mip_, cons));
-                scip_assert(SCIPreleaseCons(mip_, &cons));
+                // Get variables.
+                auto ind_var = mip_indicator_var(idx_var, idx);
+                release_assert(ind_var, "Indicator variable missing while creating element constraint");
+                Vector<SCIP_VAR*> mip_vars{mip_var(val_var), mip_var(array[idx - 1])};
+
+                // Create constraint <=.
+                {
+                    Vector<Float> coeffs{1, -1};
+                    SCIP_CONS* cons;
+                    scip_assert(SCIPcreateConsBasicIndicator(mip_,
+                                                             &cons,
+                                                             "",
+                                                             ind_var,
+                                                             2,
+                                                             mip_vars.data(),
+                                                             coeffs.data(),
+                                                             0));
+                    scip_assert(SCIPaddCons(mip_, cons));
+                    scip_assert(SCIPreleaseCons(mip_, &cons));
+                }
+
+                // Create constraint >=.
+                {
+                    Vector<Float> coeffs{-1, 1};
+                    SCIP_CONS* cons;
+                    scip_assert(SCIPcreateConsBasicIndicator(mip_,
+                                                             &cons,
+                                                             "",
+                                                             ind_var,
+                                                             2,
+                                                             mip_vars.data(),
+                                                             coeffs.data(),
+                                                             0));
+                    scip_assert(SCIPaddCons(mip_, cons));
+                    scip_assert(SCIPreleaseCons(mip_, &cons));
+                }
             }
         }
     }
 
     // Create constraint in CP.
     CREATE_CP_CONSTRAINT:
+    {
+        Vector<IntVar> scope_vars(array);
+        scope_vars.push_back(idx_var);
+        scope_vars.push_back(val_var);
+        add_cp_scope({}, scope_vars);
+    }
     {
         const Int size = array.size();
         vec<geas::intvar> cp_array(size);
@@ -467,7 +687,7 @@ bool Model::add_constr_element(const IntVar& idx_var, const Vector<IntVar>& arra
         {
             cp_array[idx] = cp_var(array[idx]);
         }
-        geas::var_int_element(cp_.data, cp_var(val_var), cp_var(idx_var), cp_array);
+        geas::var_int_element(cp_->data, cp_var(val_var), cp_var(idx_var), cp_array);
     }
 
     // Success.
@@ -476,6 +696,9 @@ bool Model::add_constr_element(const IntVar& idx_var, const Vector<IntVar>& arra
 
 bool Model::add_constr_alldifferent(const Vector<IntVar>& vars)
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     for (const auto var : vars)
     {
@@ -519,19 +742,143 @@ bool Model::add_constr_alldifferent(const Vector<IntVar>& vars)
             }
             scip_assert(SCIPreleaseCons(mip_, &cons));
         }
+
+        // Register the variables for separating Hall-interval cuts. SCIP already turns the packings into
+        // cliques during presolving.
+        Vector<IntVar> mip_vars;
+        for (const auto var : vars)
+            if (mip_var(var))
+            {
+                mip_vars.push_back(var);
+            }
+        if (mip_vars.size() > 1)
+        {
+            if (!SCIPfindSepa(mip_, "alldifferent"))
+            {
+                scip_assert(includeSepaAllDifferent(mip_));
+            }
+            probdata_->alldifferents_.push_back(std::move(mip_vars));
+        }
     }
 
     // Create constraint in CP.
+    add_cp_scope({}, vars);
     {
         const Int N = vars.size();
         vec<geas::intvar> cp_vars(N);
         for (Int idx = 0; idx < N; ++idx)
             cp_vars[idx] = cp_var(vars[idx]);
-        geas_add_constr(geas::all_different_int(cp_.data, cp_vars));
+        geas_add_constr(geas::all_different_int(cp_->data, cp_vars));
     }
 
     // Success
     return true;
 }
 
+bool Model::add_symmetry(const Vector<Vector<BoolVar>>& bool_vars, const Vector<Vector<IntVar>>& int_vars)
+{
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
+    // Check.
+    const Int nb_cols = std::max(bool_vars.size(), int_vars.size());
+    release_assert(bool_vars.empty() || static_cast<Int>(bool_vars.size()) == nb_cols,
+                   "Symmetry has {} columns of Boolean variables but {} columns of integer variables",
+                   bool_vars.size(), int_vars.size());
+    release_assert(int_vars.empty() || static_cast<Int>(int_vars.size()) == nb_cols,
+                   "Symmetry has {} columns of Boolean variables but {} columns of integer variables",
+                   bool_vars.size(), int_vars.size());
+    for (const auto& col : bool_vars)
+    {
+        release_assert(col.size() == bool_vars[0].size(), "Columns of symmetry have different lengths");
+        for (const auto var : col)
+        {
+            release_assert(var.model == this, "Variable belongs to a different model");
+            release_assert(0 <= var.idx && var.idx < nb_bool_vars(), "Variable is invalid");
+        }
+    }
+    for (const auto& col : int_vars)
+    {
+        release_assert(col.size() == int_vars[0].size(), "Columns of symmetry have different lengths");
+        for (const auto var : col)
+        {
+            release_assert(var.model == this, "Variable belongs to a different model");
+            release_assert(0 <= var.idx && var.idx < nb_int_vars(), "Variable is invalid");
+        }
+    }
+    if (nb_cols <= 1)
+    {
+        return true;
+    }
+
+    // Store the group for copying nogoods.
+    SymmetryGroup group;
+    for (const auto& col : bool_vars)
+    {
+        auto& group_col = group.bool_vars_idx.emplace_back();
+        for (const auto var : col)
+            group_col.push_back(var.idx);
+    }
+    for (const auto& col : int_vars)
+    {
+        auto& group_col = group.int_vars_idx.emplace_back();
+        for (const auto var : col)
+            group_col.push_back(var.idx);
+    }
+    probdata_->symmetry_groups_.push_back(std::move(group));
+
+    // Order the columns of Boolean variables lexicographically decreasing in the MIP. The orbitope needs
+    // positive binary variables in the MIP.
+    if (!bool_vars.empty() && !bool_vars[0].empty())
+    {
+        const Int nb_rows = bool_vars[0].size();
+        bool is_binary = true;
+        for (const auto& col : bool_vars)
+            for (const auto var : col)
+            {
+                is_binary = is_binary && var.idx >= 2 && is_pos_var(var) && mip_var(var);
+            }
+        if (is_binary)
+        {
+            Vector<Vector<SCIP_VAR*>> mip_vars(nb_rows, Vector<SCIP_VAR*>(nb_cols));
+            Vector<SCIP_VAR**> mip_vars_rows(nb_rows);
+            for (Int row = 0; row < nb_rows; ++row)
+            {
+                for (Int col = 0; col < nb_cols; ++col)
+                {
+                    mip_vars[row][col] = mip_var(bool_vars[col][row]);
+                }
+                mip_vars_rows[row] = mip_vars[row].data();
+            }
+
+            // Create the orbitope without checking, so that it only prunes the search. Solutions found
+            // in CP by the primal heuristics need not order their columns and stay feasible.
+            SCIP_CONS* cons;
+            scip_assert(SCIPcreateConsOrbitope(mip_,
+                                               &cons,
+                                               fmt::format("symmetry_{}", probdata_->symmetry_groups_.size()).c_str(),
+                                               mip_vars_rows.data(),
+                                               SCIP_ORBITOPETYPE_FULL,
+                                               nb_rows,
+                                               nb_cols,
+                                               TRUE,
+                                               TRUE,
+                                               TRUE,
+                                               TRUE,
+                                               FALSE,
+                                               TRUE,
+                                               FALSE,
+                                               FALSE,
+                                               FALSE,
+                                               FALSE,
+                                               FALSE));
+            scip_assert(SCIPaddCons(mip_, cons));
+            scip_assert(SCIPreleaseCons(mip_, &cons));
+        }
+    }
+
+    // Success.
+    return true;
+}
+
 }
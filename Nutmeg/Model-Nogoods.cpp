@@ -0,0 +1,321 @@
+//#define PRINT_DEBUG
+
+#include "Model.h"
+#include "DataFile.h"
+#include "scip/cons_logicor.h"
+#include "scip/cons_bounddisjunction.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+
+#define MAX_IMPORT_CONFLICTS                      100 // maximum number of conflicts in the CP search proving an imported nogood
+
+namespace Nutmeg
+{
+
+// Key of a variable in a nogood file. Variables are identified by name if it can be read back as a
+// token, and by index otherwise.
+static String get_nogood_file_key(const String& name, const Int idx)
+{
+    const auto has_space = std::any_of(name.begin(), name.end(), [](const char c) { return std::isspace(c); });
+    if (name.empty() || has_space || name.find('=') != String::npos)
+    {
+        return fmt::format("#{}", idx);
+    }
+    else
+    {
+        return fmt::format(":{}", name);
+    }
+}
+
+Vector<NogoodData> Model::get_trans_nogoods()
+{
+    // Check.
+    debug_assert(SCIPgetStage(mip_) != SCIP_STAGE_PROBLEM);
+
+    // Translate the nogoods in the transformed problem to the original variables. Nogoods over variables
+    // created during solving have no original counterpart and are dropped.
+    Vector<NogoodData> nogoods;
+    const auto& trans_probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(mip_));
+    auto trans_nogoods = trans_probdata.nogoods_;
+    trans_probdata.nogood_pool_.get_nogoods(trans_nogoods);
+    for (const auto& trans_nogood : trans_nogoods)
+    {
+        NogoodData nogood;
+        bool is_valid = true;
+        for (size_t idx = 0; idx < trans_nogood.vars.size() && is_valid; ++idx)
+        {
+            auto var = trans_nogood.vars[idx];
+            SCIP_Real scalar = 1.0;
+            SCIP_Real constant = 0.0;
+            scip_assert(SCIPvarGetOrigvarSum(&var, &scalar, &constant));
+            is_valid = var && scalar != 0.0;
+            if (is_valid)
+            {
+                const auto sign = trans_nogood.signs[idx];
+                nogood.vars.push_back(var);
+                nogood.signs.push_back(scalar > 0 ? sign :
+                                       sign == SCIP_BOUNDTYPE_LOWER ? SCIP_BOUNDTYPE_UPPER : SCIP_BOUNDTYPE_LOWER);
+                nogood.bounds.push_back((trans_nogood.bounds[idx] - constant) / scalar);
+                nogood.all_binary = nogood.all_binary && SCIPvarIsBinary(var);
+            }
+        }
+        if (is_valid)
+        {
+            nogoods.push_back(std::move(nogood));
+        }
+    }
+    return nogoods;
+}
+
+void Model::add_original_nogood(const NogoodData& nogood)
+{
+    // Check.
+    debug_assert(SCIPgetStage(mip_) == SCIP_STAGE_PROBLEM);
+    debug_assert(!nogood.vars.empty());
+
+    // Create constraint.
+    SCIP_CONS* cons = nullptr;
+    if (nogood.all_binary)
+    {
+        auto vars = nogood.vars;
+        for (size_t idx = 0; idx < vars.size(); ++idx)
+            if (nogood.signs[idx] == SCIP_BOUNDTYPE_UPPER)
+            {
+                scip_assert(SCIPgetNegatedVar(mip_, vars[idx], &vars[idx]));
+            }
+        scip_assert(SCIPcreateConsBasicLogicor(mip_, &cons, "nogood", vars.size(), vars.data()));
+    }
+    else
+    {
+        auto signs = nogood.signs;
+        auto bounds = nogood.bounds;
+        auto vars = nogood.vars;
+        scip_assert(SCIPcreateConsBasicBounddisjunction(mip_,
+                                                        &cons,
+                                                        "nogood",
+                                                        vars.size(),
+                                                        vars.data(),
+                                                        signs.data(),
+                                                        bounds.data()));
+    }
+    debug_assert(cons);
+    scip_assert(SCIPaddCons(mip_, cons));
+    scip_assert(SCIPreleaseCons(mip_, &cons));
+
+    // Keep the nogood for exporting.
+    probdata_->nogoods_.push_back(nogood);
+}
+
+void Model::export_nogoods(const String& file_path)
+{
+    // Get the nogoods added to the original problem and the nogoods found in the last solve.
+    auto nogoods = probdata_->nogoods_;
+    if (SCIPgetStage(mip_) != SCIP_STAGE_PROBLEM)
+    {
+        auto trans_nogoods = get_trans_nogoods();
+        nogoods.insert(nogoods.end(), trans_nogoods.begin(), trans_nogoods.end());
+    }
+
+    // Get the keys of the variables in the MIP. An integer variable can share its MIP variable with a
+    // Boolean variable, in which case the Boolean variable is used.
+    HashTable<SCIP_VAR*, String> keys;
+    for (Int idx = 2; idx < nb_bool_vars(); ++idx)
+        if (auto mip_var = probdata_->mip_bool_vars_[idx]; mip_var && is_pos_var(BoolVar(this, idx)))
+        {
+            keys.emplace(mip_var, "b" + get_nogood_file_key(probdata_->bool_vars_name_[idx], idx));
+        }
+    for (Int idx = 1; idx < nb_int_vars(); ++idx)
+        if (auto mip_var = probdata_->mip_int_vars_[idx]; mip_var)
+        {
+            keys.emplace(mip_var, "i" + get_nogood_file_key(probdata_->int_vars_name_[idx], idx));
+        }
+
+    // Write one nogood per line as a disjunction of bounds.
+    auto file = std::fopen(file_path.c_str(), "w");
+    if (!file)
+    {
+        err("Cannot open nogood file {}", file_path);
+    }
+    fmt::print(file, "% Nutmeg nogoods\n");
+    Int nb_exported = 0;
+    for (const auto& nogood : nogoods)
+    {
+        String line;
+        for (size_t idx = 0; idx < nogood.vars.size(); ++idx)
+        {
+            // Write a bound on a negated variable as the opposite bound on the variable it negates.
+            auto var = nogood.vars[idx];
+            auto sign = nogood.signs[idx];
+            auto bound = nogood.bounds[idx];
+            if (SCIPvarIsNegated(var))
+            {
+                var = SCIPvarGetNegationVar(var);
+                sign = sign == SCIP_BOUNDTYPE_LOWER ? SCIP_BOUNDTYPE_UPPER : SCIP_BOUNDTYPE_LOWER;
+                bound = SCIPvarGetNegationConstant(nogood.vars[idx]) - bound;
+            }
+
+            // Write the bound.
+            const auto it = keys.find(var);
+            if (it == keys.end())
+            {
+                line.clear();
+                break;
+            }
+            fmt::format_to(std::back_inserter(line),
+                           "{}{}{}{}",
+                           line.empty() ? "" : " ",
+                           it->second,
+                           sign == SCIP_BOUNDTYPE_LOWER ? ">=" : "<=",
+                           static_cast<Int>(std::round(bound)));
+        }
+        if (!line.empty())
+        {
+            fmt::print(file, "{}\n", line);
+            ++nb_exported;
+        }
+    }
+    std::fclose(file);
+    debugln("Exported {} of {} nogoods to {}", nb_exported, nogoods.size(), file_path);
+}
+
+Int Model::import_nogoods(const String& file_path)
+{
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
+    // Nothing can be proven in an infeasible model.
+    if (status_ == Status::Infeasible)
+    {
+        return 0;
+    }
+
+    // Index the variables by name. Names used by more than one variable cannot identify a variable.
+    HashTable<String, Int> bool_vars_idx;
+    HashTable<String, Int> int_vars_idx;
+    for (Int idx = 2; idx < nb_bool_vars(); ++idx)
+        if (is_pos_var(BoolVar(this, idx)))
+        {
+            const auto [it, inserted] = bool_vars_idx.emplace(probdata_->bool_vars_name_[idx], idx);
+            if (!inserted)
+            {
+                it->second = -1;
+            }
+        }
+    for (Int idx = 1; idx < nb_int_vars(); ++idx)
+    {
+        const auto [it, inserted] = int_vars_idx.emplace(probdata_->int_vars_name_[idx], idx);
+        if (!inserted)
+        {
+            it->second = -1;
+        }
+    }
+
+    // Read the nogoods.
+    const MappedFile file(file_path);
+    Tokenizer lines(file.view());
+    Int nb_read = 0;
+    Int nb_imported = 0;
+    while (!lines.at_end())
+    {
+        // Skip comments and empty lines.
+        const auto line = lines.next_line();
+        if (line.empty() || line.front() == '%')
+        {
+            continue;
+        }
+        ++nb_read;
+
+        // Parse the literals and assume their negation in the CP solver. The nogood is valid in this
+        // model if the CP solver proves the negation infeasible.
+        NogoodData nogood;
+        bool is_valid = true;
+        bool is_proven = false;
+        cp_->clear_assumptions();
+        Tokenizer tokens(line);
+        for (auto token = tokens.next_token(); !token.empty() && is_valid && !is_proven; token = tokens.next_token())
+        {
+            // Split the literal into variable and bound.
+            const auto op_pos = token.find('=');
+            is_valid = token.size() >= 4 && op_pos != StringView::npos && op_pos >= 3 &&
+                       (token[0] == 'b' || token[0] == 'i') &&
+                       (token[1] == ':' || token[1] == '#') &&
+                       (token[op_pos - 1] == '<' || token[op_pos - 1] == '>');
+            if (!is_valid)
+            {
+                break;
+            }
+            const auto is_int = token[0] == 'i';
+            const auto key = token.substr(2, op_pos - 3);
+            const auto sign = token[op_pos - 1] == '>' ? SCIP_BOUNDTYPE_LOWER : SCIP_BOUNDTYPE_UPPER;
+            const auto bound = parse_int(token.substr(op_pos + 1));
+
+            // Find the variable.
+            Int idx = -1;
+            if (token[1] == '#')
+            {
+                idx = parse_int(key);
+            }
+            else
+            {
+                const auto& vars_idx = is_int ? int_vars_idx : bool_vars_idx;
+                const auto it = vars_idx.find(String(key));
+                idx = it != vars_idx.end() ? it->second : -1;
+            }
+            if (is_int)
+            {
+                is_valid = 1 <= idx && idx < nb_int_vars() && probdata_->mip_int_vars_[idx];
+            }
+            else
+            {
+                is_valid = 2 <= idx && idx < nb_bool_vars() && is_pos_var(BoolVar(this, idx)) &&
+                           probdata_->mip_bool_vars_[idx] && (bound == 0 || bound == 1);
+            }
+            if (!is_valid)
+            {
+                break;
+            }
+
+            // Add the literal and assume its negation.
+            if (is_int)
+            {
+                const auto& cp_var = probdata_->cp_int_vars_[idx];
+                nogood.vars.push_back(probdata_->mip_int_vars_[idx]);
+                nogood.all_binary = nogood.all_binary && SCIPvarIsBinary(nogood.vars.back());
+                is_proven = sign == SCIP_BOUNDTYPE_LOWER ? !cp_->assume(cp_var <= bound - 1) :
+                                                           !cp_->assume(cp_var >= bound + 1);
+            }
+            else
+            {
+                const auto& cp_var = probdata_->cp_bool_vars_[idx];
+                nogood.vars.push_back(probdata_->mip_bool_vars_[idx]);
+                is_proven = sign == SCIP_BOUNDTYPE_LOWER ? !cp_->assume(~cp_var) : !cp_->assume(cp_var);
+            }
+            nogood.signs.push_back(sign);
+            nogood.bounds.push_back(bound);
+        }
+
+        // Prove the nogood by search if propagation does not.
+        if (is_valid && !is_proven && !nogood.vars.empty())
+        {
+            const auto cp_result = cp_->solve(limits{.conflicts = MAX_IMPORT_CONFLICTS});
+            is_proven = cp_result == geas::solver::UNSAT;
+        }
+        cp_->clear_assumptions();
+
+        // Add the nogood. Literals parsed after the negation failed are not needed.
+        if (is_valid && is_proven && !nogood.vars.empty())
+        {
+            add_original_nogood(nogood);
+            ++nb_imported;
+        }
+    }
+    debugln("Imported {} of {} nogoods from {}", nb_imported, nb_read, file_path);
+
+    // Done.
+    return nb_imported;
+}
+
+}
@@ -1,6 +1,10 @@
 //#define PRINT_DEBUG
 
 #include "Model.h"
+#include <algorithm>
+
+#define MAX_HINT_DURATION                         1.0 // maximum run time of the CP search completing the hints
+#define MAX_HINT_CONFLICTS                      10000 // maximum number of conflicts in the CP search completing the hints
 
 namespace Nutmeg
 {
@@ -25,28 +29,38 @@ void Model::minimize_using_bc(
     release_assert(obj_var.model == this, "Objective variable belongs to a different model");
     release_assert(0 <= obj_var.idx && obj_var.idx < nb_int_vars(), "Objective variable is invalid");
     release_assert(mip_var(obj_var), "Objective variable is not in the MIP model");
+    if (probdata_->obj_var_idx_ >= 0 && probdata_->obj_var_idx_ != obj_var.idx)
+    {
+        scip_assert(SCIPchgVarObj(mip_, probdata_->mip_int_vars_[probdata_->obj_var_idx_], 0.0));
+    }
     scip_assert(SCIPchgVarObj(mip_, mip_var(obj_var), 1.0));
-    probdata_.obj_var_idx_ = obj_var.idx;
+    probdata_->obj_var_idx_ = obj_var.idx;
 
     // Set dual bound.
     obj_bound_ = lb(obj_var);
 
-    // Add variables to monitor of bounds changes.
-    for (Int idx = 0; idx < nb_bool_vars(); ++idx)
+    // Add variables to monitor of bounds changes. Variables monitored in an earlier solve are skipped.
+    for (Int idx = probdata_->nb_monitored_bool_vars_; idx < nb_bool_vars(); ++idx)
     {
-        probdata_.bool_vars_monitor_.monitor(geas::atom_var(probdata_.cp_bool_vars_[idx]), idx);
+        probdata_->bool_vars_monitor_.monitor(geas::atom_var(probdata_->cp_bool_vars_[idx]), idx);
     }
+    probdata_->nb_monitored_bool_vars_ = nb_bool_vars();
+    probdata_->int_vars_monitored_.resize(nb_int_vars(), false);
     for (Int idx = 0; idx < nb_int_vars(); ++idx)
-        if (probdata_.mip_int_vars_[idx])
+        if (probdata_->mip_int_vars_[idx] && !probdata_->int_vars_monitored_[idx])
         {
-            probdata_.int_vars_monitor_.monitor(probdata_.cp_int_vars_[idx], idx);
+            probdata_->int_vars_monitor_.monitor(probdata_->cp_int_vars_[idx], idx);
+            probdata_->int_vars_monitored_[idx] = true;
         }
-    if (!cp_.is_consistent())
+    if (!cp_->is_consistent())
     {
         status_ = Status::Infeasible;
         goto EXIT;
     }
 
+    // Split the CP subproblem into independent components.
+    probdata_->compute_cp_components();
+
     // Create space to store solution.
     sol_.bool_vars_sol_.resize(nb_bool_vars());
     sol_.int_vars_sol_.resize(nb_int_vars(), std::numeric_limits<Int>::max());
@@ -59,24 +73,39 @@ void Model::minimize_using_bc(
     {
         scip_assert(SCIPsetIntParam(mip_, "display/verblevel", 0));
     }
+    else
+    {
+        scip_assert(SCIPresetParam(mip_, "display/verblevel"));
+    }
 
     // Start timer.
     if (time_limit < Infinity)
     {
         scip_assert(SCIPsetRealParam(mip_, "limits/time", time_limit));
     }
+    else
+    {
+        scip_assert(SCIPresetParam(mip_, "limits/time"));
+    }
     start_timer(time_limit);
 
+    // Give the solution hints to SCIP.
+    if (!probdata_->bool_vars_hint_.empty() || !probdata_->int_vars_hint_.empty())
+    {
+        add_solution_hints_to_mip(time_limit);
+    }
+
     // Solve.
     scip_assert(SCIPsolve(mip_));
 //    scip_assert(SCIPwriteTransProblem(mip_, "model_transform.lp", 0, 0));
 
     // Stop timer.
-    run_time_ = get_cpu_time();
+    run_time_ = get_time_elapsed();
 
     // Print statistics.
     if (verbose)
     {
+        std::lock_guard<std::recursive_mutex> lock(output_mutex());
         println("");
         scip_assert(SCIPprintStatistics(mip_, nullptr));
     }
@@ -104,13 +133,24 @@ void Model::minimize_using_bc(
         debug_assert(obj_ == SCIPround(mip_, SCIPgetPrimalbound(mip_)));
     }
 
-    // Get dual bound.
+    // Get dual bound from the MIP and from the objective bounds proven by the CP subproblem. The
+    // CP bound is stored in the problem data of the transformed problem.
     {
         const auto new_obj_bound = SCIPceil(mip_, SCIPgetDualbound(mip_));
         if (new_obj_bound > obj_bound_)
         {
             obj_bound_ = new_obj_bound;
         }
+
+        const auto& trans_probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(mip_));
+        if (trans_probdata.cp_dual_bound_ > obj_bound_)
+        {
+            obj_bound_ = trans_probdata.cp_dual_bound_;
+        }
+        if (sol && obj_bound_ > obj_)
+        {
+            obj_bound_ = obj_;
+        }
     }
 
     // Get status.
@@ -141,10 +181,11 @@ void Model::minimize_using_bc(
     EXIT:
     if (verbose)
     {
+        std::lock_guard<std::recursive_mutex> lock(output_mutex());
         println("");
         println("--------------------------------------------------");
         println("Method: BC");
-        println("CPU time: {:.2f} seconds", run_time_);
+        println("Wall time: {:.2f} seconds", run_time_);
         println("Status: {}",
                 status_ == Status::Unknown ? "Unknown" :
                 status_ == Status::Optimal ? "Optimal" :
@@ -170,14 +211,97 @@ void Model::minimize_using_bc(
         println("Solution:");
         for (Int idx = 0; idx < nb_int_vars(); ++idx)
         {
-            println("   {} = {}", probdata_.int_vars_name_[idx], sol_.int_vars_sol_[idx]);
+            println("   {} = {}", probdata_->int_vars_name_[idx], sol_.int_vars_sol_[idx]);
         }
         for (Int idx = 0; idx < nb_bool_vars(); ++idx)
         {
-            println("   {} = {}", probdata_.bool_vars_name_[idx], sol_.bool_vars_sol_[idx]);
+            println("   {} = {}", probdata_->bool_vars_name_[idx], sol_.bool_vars_sol_[idx]);
         }
     }
 #endif
 }
 
+void Model::add_solution_hints_to_mip(const Float time_limit)
+{
+    // Assume the hints in the CP solver.
+    bool is_feasible = true;
+    cp_->clear_assumptions();
+    for (const auto& [idx, val] : probdata_->bool_vars_hint_)
+    {
+        const auto& cp_var = probdata_->cp_bool_vars_[idx];
+        is_feasible = is_feasible && cp_->assume(val ? cp_var : ~cp_var);
+    }
+    for (const auto& [idx, val] : probdata_->int_vars_hint_)
+    {
+        const auto& cp_var = probdata_->cp_int_vars_[idx];
+        is_feasible = is_feasible && cp_->assume(cp_var >= val) && cp_->assume(cp_var <= val);
+    }
+
+    // Complete the hints in the CP solver. A feasible completion replaces the hints in the partial
+    // solution given to SCIP, so only the auxiliary variables of the MIP relaxation are left for SCIP to
+    // complete.
+    auto bool_vars_val = probdata_->bool_vars_hint_;
+    auto int_vars_val = probdata_->int_vars_hint_;
+    if (is_feasible)
+    {
+        const auto cp_result = cp_->solve(limits{.time = std::min(MAX_HINT_DURATION, time_limit),
+                                                .conflicts = MAX_HINT_CONFLICTS});
+        debugln("Completing {} solution hints: {}",
+                probdata_->bool_vars_hint_.size() + probdata_->int_vars_hint_.size(),
+                cp_result == geas::solver::SAT ? "SAT" : cp_result == geas::solver::UNSAT ? "UNSAT" : "UNKNOWN");
+        if (cp_result == geas::solver::SAT)
+        {
+            bool_vars_val.clear();
+            int_vars_val.clear();
+            for (Int idx = 2; idx < nb_bool_vars(); ++idx)
+                if (probdata_->is_pos_var(idx))
+                {
+                    bool_vars_val.emplace_back(idx, probdata_->cp_bool_vars_[idx].lb(cp_->data->state.p_vals));
+                }
+            for (Int idx = 1; idx < nb_int_vars(); ++idx)
+            {
+                int_vars_val.emplace_back(idx, probdata_->cp_int_vars_[idx].lb(cp_->data));
+            }
+        }
+    }
+    cp_->clear_assumptions();
+
+    // Give the values of variables in the MIP to SCIP as a partial solution for its completion heuristic,
+    // which decides whether it becomes a solution. The hints stay in the problem data to guide the CP
+    // rounding heuristic.
+    SCIP_SOL* sol = nullptr;
+    scip_assert(SCIPcreatePartialSol(mip_, &sol, nullptr));
+    const auto set_bool_var_hint = [&](const Int idx, const bool val)
+    {
+        const auto pos_idx = probdata_->is_pos_var(idx) ? idx : probdata_->mip_neg_vars_idx_[idx];
+        if (const auto mip_var = probdata_->mip_bool_vars_[pos_idx]; mip_var)
+        {
+            scip_assert(SCIPsetSolVal(mip_, sol, mip_var, pos_idx == idx ? val : !val));
+        }
+    };
+    for (const auto& [idx, val] : bool_vars_val)
+    {
+        set_bool_var_hint(idx, val);
+    }
+    for (const auto& [idx, val] : int_vars_val)
+        if (const auto mip_var = probdata_->mip_int_vars_[idx]; mip_var)
+        {
+            scip_assert(SCIPsetSolVal(mip_, sol, mip_var, val));
+        }
+        else if (const auto& indicator_vars_idx = probdata_->mip_indicator_vars_idx_[idx];
+                 !indicator_vars_idx.empty())
+        {
+            const auto val_idx = val - probdata_->int_vars_lb_[idx];
+            release_assert(0 <= val_idx && val_idx < static_cast<Int>(indicator_vars_idx.size()),
+                           "Hint {} for variable {} is outside its domain", val, probdata_->int_vars_name_[idx]);
+            const auto indicator_var_idx = indicator_vars_idx[val_idx];
+            if (indicator_var_idx >= 2)
+            {
+                set_bool_var_hint(indicator_var_idx, true);
+            }
+        }
+    SCIP_Bool stored = FALSE;
+    scip_assert(SCIPaddSolFree(mip_, &sol, &stored));
+}
+
 }
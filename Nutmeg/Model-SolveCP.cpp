@@ -24,7 +24,7 @@ void Model::minimize_using_cp(
     // Add objective function.
     release_assert(obj_var.model == this, "Objective variable belongs to a different model");
     release_assert(0 <= obj_var.idx && obj_var.idx < nb_int_vars(), "Objective variable is invalid");
-    probdata_.obj_var_idx_ = obj_var.idx;
+    probdata_->obj_var_idx_ = obj_var.idx;
 
     // Set dual bound.
     obj_bound_ = lb(obj_var);
@@ -38,25 +38,25 @@ void Model::minimize_using_cp(
 
     // Solve.
     SOLVE:
-    result = cp_.solve(limits{.time = get_time_remaining(), .conflicts = 0});
+    result = cp_->solve(limits{.time = get_time_remaining(), .conflicts = 0});
 
     // Get solution.
     if (result == geas::solver::SAT)
     {
         // Store objective value.
-        obj_ = probdata_.cp_int_vars_[obj_var.idx].lb(cp_.data);
+        obj_ = probdata_->cp_int_vars_[obj_var.idx].lb(cp_->data);
         debug_assert(obj_ < sol_.int_vars_sol_[obj_var.idx]);
 
         // Store solution.
         for (Int idx = 0; idx < nb_bool_vars(); ++idx)
         {
-            const auto& cp_var = probdata_.cp_bool_vars_[idx];
-            sol_.bool_vars_sol_[idx] = cp_var.lb(cp_.data->state.p_vals);
+            const auto& cp_var = probdata_->cp_bool_vars_[idx];
+            sol_.bool_vars_sol_[idx] = cp_var.lb(cp_->data->state.p_vals);
         }
         for (Int idx = 0; idx < nb_int_vars(); ++idx)
         {
-            const auto& cp_var = probdata_.cp_int_vars_[idx];
-            sol_.int_vars_sol_[idx] = cp_var.lb(cp_.data);
+            const auto& cp_var = probdata_->cp_int_vars_[idx];
+            sol_.int_vars_sol_[idx] = cp_var.lb(cp_->data);
         }
 
         // Print solution.
@@ -70,7 +70,7 @@ void Model::minimize_using_cp(
         }
 
         // Tighten primal bound.
-        if (cp_.post(probdata_.cp_int_vars_[obj_var.idx] < obj_))
+        if (cp_->post(probdata_->cp_int_vars_[obj_var.idx] < obj_))
         {
             // Solve again.
             goto SOLVE;
@@ -83,7 +83,7 @@ void Model::minimize_using_cp(
     }
 
     // Stop timer.
-    run_time_ = get_cpu_time();
+    run_time_ = get_time_elapsed();
 
     // Get status.
     debug_assert(result == geas::solver::UNSAT || result == geas::solver::UNKNOWN);
@@ -116,10 +116,11 @@ void Model::minimize_using_cp(
     // Print status.
     if (verbose)
     {
+        std::lock_guard<std::recursive_mutex> lock(output_mutex());
         println("");
         println("--------------------------------------------------");
         println("Method: CP");
-        println("CPU time: {:.2f} seconds", run_time_);
+        println("Wall time: {:.2f} seconds", run_time_);
         println("Status: {}",
                 status_ == Status::Unknown ? "Unknown" :
                 status_ == Status::Optimal ? "Optimal" :
@@ -145,11 +146,11 @@ void Model::minimize_using_cp(
         println("Solution:");
         for (Int idx = 0; idx < nb_int_vars(); ++idx)
         {
-            println("   {} = {}", probdata_.int_vars_name_[idx], sol_.int_vars_sol_[idx]);
+            println("   {} = {}", probdata_->int_vars_name_[idx], sol_.int_vars_sol_[idx]);
         }
         for (Int idx = 0; idx < nb_bool_vars(); ++idx)
         {
-            println("   {} = {}", probdata_.bool_vars_name_[idx], sol_.bool_vars_sol_[idx]);
+            println("   {} = {}", probdata_->bool_vars_name_[idx], sol_.bool_vars_sol_[idx]);
         }
     }
 #endif
@@ -30,7 +30,7 @@ void Model::minimize_using_lbbd(
 //    release_assert(obj_var.is_valid(), "Objective variable is not valid");
 //    release_assert(has_mip_var(obj_var), "Objective variable must appear in the MIP");
 //    scip_assert(SCIPchgVarObj(mip_, mip_var(obj_var), 1.0));
-//    probdata_.obj_var_idx_ = obj_var.idx;
+//    probdata_->obj_var_idx_ = obj_var.idx;
 //
 //    // Create space to store solution.
 //    sol_.bool_vars_sol_.resize(nb_bool_vars());
@@ -102,7 +102,7 @@ void Model::minimize_using_lbbd(
 //        {
 //            // Make assumptions.
 //            debugln("   Assumptions:");
-//            cp_.clear_assumptions();
+//            cp_->clear_assumptions();
 //            if (!make_bool_assumptions(mip_, sol, probdata_, cp_))
 //            {
 //                debugln("   Assumptions infeasible");
@@ -128,7 +128,7 @@ void Model::minimize_using_lbbd(
 //                debugln("   Calling Geas");
 //                const auto start_time = clock();
 //#endif
-//                cp_result = cp_.solve(limits{.time = time_remaining, .conflicts = 0});
+//                cp_result = cp_->solve(limits{.time = time_remaining, .conflicts = 0});
 //#ifdef PRINT_DEBUG
 //                debugln("   Geas run time = {:.3f}",
 //                        static_cast<double>(clock() - start_time) / CLOCKS_PER_SEC);
@@ -141,7 +141,7 @@ void Model::minimize_using_lbbd(
 //        {
 //            // Make additional assumptions.
 //            debugln("   Assumptions:");
-//            cp_.clear_assumptions();
+//            cp_->clear_assumptions();
 //            if (!make_bool_assumptions(mip_, sol, probdata_, cp_) ||
 //                !make_obj_assumptions(mip_, sol, probdata_, cp_))
 //            {
@@ -168,7 +168,7 @@ void Model::minimize_using_lbbd(
 //                debugln("   Calling Geas");
 //                const auto start_time = clock();
 //#endif
-//                cp_result = cp_.solve(limits{.time = time_remaining, .conflicts = 0});
+//                cp_result = cp_->solve(limits{.time = time_remaining, .conflicts = 0});
 //#ifdef PRINT_DEBUG
 //                debugln("   Geas run time = {:.3f}",
 //                        static_cast<double>(clock() - start_time) / CLOCKS_PER_SEC);
@@ -181,7 +181,7 @@ void Model::minimize_using_lbbd(
 //        {
 //            // Make additional assumptions.
 //            debugln("   Assumptions:");
-//            cp_.clear_assumptions();
+//            cp_->clear_assumptions();
 //            if (!make_bool_assumptions(mip_, sol, probdata_, cp_) ||
 //                !make_int_assumptions(mip_, sol, probdata_, cp_))
 //            {
@@ -208,7 +208,7 @@ void Model::minimize_using_lbbd(
 //                debugln("   Calling Geas");
 //                const auto start_time = clock();
 //#endif
-//                cp_result = cp_.solve(limits{.time = time_remaining, .conflicts = 0});
+//                cp_result = cp_->solve(limits{.time = time_remaining, .conflicts = 0});
 //#ifdef PRINT_DEBUG
 //                debugln("   Geas run time = {:.3f}",
 //                        static_cast<double>(clock() - start_time) / CLOCKS_PER_SEC);
@@ -220,8 +220,8 @@ void Model::minimize_using_lbbd(
 //        if (cp_result == geas::solver::SAT)
 //        {
 //            // Store objective value.
-//            debug_assert(obj_ > probdata_.cp_int_vars_[obj_var.idx].lb(cp_.data));
-//            obj_ = probdata_.cp_int_vars_[obj_var.idx].lb(cp_.data);
+//            debug_assert(obj_ > probdata_->cp_int_vars_[obj_var.idx].lb(cp_->data));
+//            obj_ = probdata_->cp_int_vars_[obj_var.idx].lb(cp_->data);
 //            println("Found new solution with objective value {}", obj_);
 //
 //            // Check.
@@ -233,13 +233,13 @@ void Model::minimize_using_lbbd(
 //            // Store solution.
 //            for (Int idx = 0; idx < nb_bool_vars(); ++idx)
 //            {
-//                const auto& cp_var = probdata_.cp_bool_vars_[idx];
-//                sol_.bool_vars_sol_[idx] = cp_var.lb(cp_.data->state.p_vals);
+//                const auto& cp_var = probdata_->cp_bool_vars_[idx];
+//                sol_.bool_vars_sol_[idx] = cp_var.lb(cp_->data->state.p_vals);
 //            }
 //            for (Int idx = 0; idx < nb_int_vars(); ++idx)
 //            {
-//                const auto& cp_var = probdata_.cp_int_vars_[idx];
-//                sol_.int_vars_sol_[idx] = cp_var.lb(cp_.data);
+//                const auto& cp_var = probdata_->cp_int_vars_[idx];
+//                sol_.int_vars_sol_[idx] = cp_var.lb(cp_->data);
 //            }
 //
 //            // Optimal.
@@ -349,7 +349,7 @@ void Model::minimize_using_lbbd(
 //    }
 //
 //    // Stop timer.
-//    run_time_ = get_cpu_time();
+//    run_time_ = get_time_elapsed();
 //
 //    // Print status.
 //    EXIT:
@@ -382,12 +382,12 @@ void Model::minimize_using_lbbd(
 //        for (Int idx = 0; idx < nb_int_vars(); ++idx)
 //        {
 //            println("   {} = {}",
-//                    probdata_.int_vars_name_[idx], sol_.int_vars_sol_[idx]);
+//                    probdata_->int_vars_name_[idx], sol_.int_vars_sol_[idx]);
 //        }
 //        for (Int idx = 0; idx < nb_bool_vars(); ++idx)
 //        {
 //            println("   {} = {}",
-//                    probdata_.bool_vars_name_[idx], sol_.bool_vars_sol_[idx]);
+//                    probdata_->bool_vars_name_[idx], sol_.bool_vars_sol_[idx]);
 //        }
 //    }
 //#endif
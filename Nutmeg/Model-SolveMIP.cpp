@@ -16,7 +16,7 @@ void Model::minimize_using_mip(
     release_assert(0 <= obj_var.idx && obj_var.idx < nb_int_vars(), "Objective variable is invalid");
     release_assert(mip_var(obj_var), "Objective variable is not in the MIP model");
     scip_assert(SCIPchgVarObj(mip_, mip_var(obj_var), 1.0));
-    probdata_.obj_var_idx_ = obj_var.idx;
+    probdata_->obj_var_idx_ = obj_var.idx;
 
     // Create space to store solution.
     sol_.bool_vars_sol_.resize(nb_bool_vars());
@@ -43,11 +43,15 @@ void Model::minimize_using_mip(
 //    scip_assert(SCIPwriteTransProblem(mip_, "model_transform.lp", 0, 0));
 
     // Stop timer.
-    run_time_ = get_cpu_time();
+    run_time_ = get_time_elapsed();
 
     // Print statistics.
-    println("");
-    scip_assert(SCIPprintStatistics(mip_, nullptr));
+    if (verbose)
+    {
+        std::lock_guard<std::recursive_mutex> lock(output_mutex());
+        println("");
+        scip_assert(SCIPprintStatistics(mip_, nullptr));
+    }
 
     // Get status.
     const auto status = SCIPgetStatus(mip_);
@@ -63,12 +67,12 @@ void Model::minimize_using_mip(
         // Store solution.
         for (Int idx = 0; idx < nb_bool_vars(); ++idx)
         {
-            const auto mip_var = probdata_.mip_bool_vars_[idx];
+            const auto mip_var = probdata_->mip_bool_vars_[idx];
             sol_.bool_vars_sol_[idx] = SCIPround(mip_, SCIPgetSolVal(mip_, sol, mip_var));
         }
         for (Int idx = 0; idx < nb_int_vars(); ++idx)
         {
-            const auto mip_var = probdata_.mip_int_vars_[idx];
+            const auto mip_var = probdata_->mip_int_vars_[idx];
             if (mip_var)
             {
                 sol_.int_vars_sol_[idx] = SCIPround(mip_, SCIPgetSolVal(mip_, sol, mip_var));
@@ -116,10 +120,11 @@ void Model::minimize_using_mip(
     // Print status.
     if (verbose)
     {
+        std::lock_guard<std::recursive_mutex> lock(output_mutex());
         println("");
         println("--------------------------------------------------");
         println("Method: MIP");
-        println("CPU time: {:.2f} seconds", run_time_);
+        println("Wall time: {:.2f} seconds", run_time_);
         println("Status: {}",
                 status_ == Status::Unknown ? "Unknown" :
                 status_ == Status::Optimal ? "Optimal" :
@@ -145,11 +150,11 @@ void Model::minimize_using_mip(
         println("Solution:");
         for (Int idx = 0; idx < nb_int_vars(); ++idx)
         {
-            println("   {} = {}", probdata_.int_vars_name_[idx], sol_.int_vars_sol_[idx]);
+            println("   {} = {}", probdata_->int_vars_name_[idx], sol_.int_vars_sol_[idx]);
         }
         for (Int idx = 0; idx < nb_bool_vars(); ++idx)
         {
-            println("   {} = {}", probdata_.bool_vars_name_[idx], sol_.bool_vars_sol_[idx]);
+            println("   {} = {}", probdata_->bool_vars_name_[idx], sol_.bool_vars_sol_[idx]);
         }
     }
 #endif
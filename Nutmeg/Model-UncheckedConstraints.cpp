@@ -3,6 +3,8 @@
 #include "Model.h"
 #include "Variable.h"
 #include "Matrix.h"
+#include "Separator-Cumulative.h"
+#include "Separator-Energetic.h"
 #include "scip/cons_linear.h"
 #include "scip/cons_knapsack.h"
 #include "scip/cons_setppc.h"
@@ -24,6 +26,9 @@ Model::add_constr_linear(
     const Int rhs_coeff
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(sign == Sign::EQ || sign == Sign::LE || sign == Sign::GE,
                    "Linear constraint only supports <=, == or >=");
@@ -89,6 +94,7 @@ Model::add_constr_linear(
     }
 
     // Create constraint in CP.
+    add_cp_scope(vars, {rhs_var});
     {
         vec<geas::patom_t> cp_vars;
         vec<int> cp_coeffs;
@@ -123,7 +129,7 @@ Model::add_constr_linear(
                     rhs_lb = rhs_coeff * ub(rhs_var);
                     rhs_ub = rhs_coeff * lb(rhs_var);
                 }
-                rhs_cp_var = cp_.new_intvar(rhs_lb, rhs_ub);
+                rhs_cp_var = cp_->new_intvar(rhs_lb, rhs_ub);
 
                 vec<geas::intvar> vars;
                 vec<int> coeffs;
@@ -132,11 +138,11 @@ Model::add_constr_linear(
                 vars.push(cp_var(rhs_var));
                 coeffs.push(-1);
                 coeffs.push(rhs_coeff);
-                geas_add_constr(geas::linear_le(cp_.data, coeffs, vars, 0, geas::at_True));
+                geas_add_constr(geas::linear_le(cp_->data, coeffs, vars, 0, geas::at_True));
 
                 coeffs[0] = -coeffs[0];
                 coeffs[1] = -coeffs[1];
-                geas_add_constr(geas::linear_le(cp_.data, coeffs, vars, 0, geas::at_True));
+                geas_add_constr(geas::linear_le(cp_->data, coeffs, vars, 0, geas::at_True));
             }
         }
         else
@@ -149,7 +155,7 @@ Model::add_constr_linear(
             // coeffs[0] * vars[0] + ... + coeffs[n-1] * vars[n-1] <= rhs + rhs_var
             // coeffs[0] * vars[0] + ... + coeffs[n-1] * vars[n-1] - rhs <= rhs_var
             // rhs_var >= coeffs[0] * vars[0] + ... + coeffs[n-1] * vars[n-1] - rhs
-            geas_add_constr(geas::bool_linear_ge(cp_.data,
+            geas_add_constr(geas::bool_linear_ge(cp_->data,
                                                  geas::at_True,
                                                  rhs_cp_var,
                                                  cp_coeffs,
@@ -161,7 +167,7 @@ Model::add_constr_linear(
             // coeffs[0] * vars[0] + ... + coeffs[n-1] * vars[n-1] >= rhs + rhs_var
             // coeffs[0] * vars[0] + ... + coeffs[n-1] * vars[n-1] - rhs >= rhs_var
             // rhs_var <= coeffs[0] * vars[0] + ... + coeffs[n-1] * vars[n-1] - rhs
-            geas_add_constr(geas::bool_linear_le(cp_.data,
+            geas_add_constr(geas::bool_linear_le(cp_->data,
                                                  geas::at_True,
                                                  rhs_cp_var,
                                                  cp_coeffs,
@@ -184,6 +190,9 @@ Model::add_constr_linear(
     const Int rhs_coeff
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(sign == Sign::EQ || sign == Sign::LE || sign == Sign::GE,
                    "Linear constraint only supports <=, == or >=");
@@ -255,6 +264,11 @@ Model::add_constr_linear(
     }
 
     // Create constraint in CP.
+    {
+        Vector<IntVar> scope_vars(vars);
+        scope_vars.push_back(rhs_var);
+        add_cp_scope({}, scope_vars);
+    }
     {
         // Create a list to store the variables of the linear constraint.
         vec<geas::intvar> cp_vars;
@@ -277,11 +291,11 @@ Model::add_constr_linear(
                 if (c < min_coeff) min_coeff = c;
                 if (c > max_coeff) max_coeff = c;
             }
-            auto coeff_var = cp_.new_intvar(min_coeff, max_coeff);
+            auto coeff_var = cp_->new_intvar(min_coeff, max_coeff);
 
             // Create element constraint to link the new CP variable. Add one because
             // element constraints are 1-indexed.
-            geas_add_constr(geas::int_element(cp_.data,
+            geas_add_constr(geas::int_element(cp_->data,
                                               coeff_var,
                                               cp_var(vars[idx]) + 1,
                                               val_coeffs));
@@ -301,7 +315,7 @@ Model::add_constr_linear(
         // Add the linear constraint.
         if (sign != Sign::GE)
         {
-            geas_add_constr(geas::linear_le(cp_.data, cp_coeffs, cp_vars, rhs));
+            geas_add_constr(geas::linear_le(cp_->data, cp_coeffs, cp_vars, rhs));
         }
         if (sign != Sign::LE)
         {
@@ -310,7 +324,7 @@ Model::add_constr_linear(
                 cp_coeffs[idx] *= -1;
             }
 
-            geas_add_constr(geas::linear_le(cp_.data, cp_coeffs, cp_vars, rhs));
+            geas_add_constr(geas::linear_le(cp_->data, cp_coeffs, cp_vars, rhs));
         }
     }
 
@@ -323,6 +337,9 @@ Model::add_constr_set_partition(
     const Vector<BoolVar>& vars
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Create constraint in MIP.
     {
         SCIP_CONS* cons;
@@ -340,9 +357,10 @@ Model::add_constr_set_partition(
     }
 
     // Create clauses in CP.
+    add_cp_scope(vars, {});
     if (vars.empty())
     {
-        geas_add_constr(cp_.post(geas::at_False));
+        geas_add_constr(cp_->post(geas::at_False));
     }
     else
     {
@@ -351,13 +369,13 @@ Model::add_constr_set_partition(
             for (const auto& var : vars)
                 clause.push(cp_var(var));
 
-            geas_add_constr(geas::add_clause(*cp_.data, clause));
+            geas_add_constr(geas::add_clause(*cp_->data, clause));
         }
         {
             for (size_t i = 0; i < vars.size() - 1; ++i)
                 for (size_t j = i + 1; j < vars.size(); ++j)
                 {
-                    geas_add_constr(geas::add_clause(cp_.data,
+                    geas_add_constr(geas::add_clause(cp_->data,
                                                      ~cp_var(vars[i]),
                                                      ~cp_var(vars[j])));
                 }
@@ -375,6 +393,9 @@ Model::add_constr_subtraction_leq(
     const Int rhs
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(x.is_valid() && y.is_valid(),
                    "Variable is not valid in creating subtraction_leq constraint");
@@ -398,7 +419,8 @@ Model::add_constr_subtraction_leq(
     }
 
     // Create constraint in CP.
-    geas_add_constr(geas::int_le(cp_.data, cp_var(x), cp_var(y), rhs));
+    add_cp_scope({}, {x, y});
+    geas_add_constr(geas::int_le(cp_->data, cp_var(x), cp_var(y), rhs));
 
     // Success.
     return true;
@@ -412,6 +434,9 @@ Model::add_constr_reify_subtraction_leq(
     const Int rhs
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(r.is_valid() && x.is_valid() && y.is_valid(),
                    "Variable is not valid in creating reify_subtraction_leq constraint");
@@ -436,7 +461,8 @@ Model::add_constr_reify_subtraction_leq(
     }
 
     // Create constraint in CP.
-    geas_add_constr(geas::int_le(cp_.data, cp_var(x), cp_var(y), rhs, cp_var(r)));
+    add_cp_scope({r}, {x, y});
+    geas_add_constr(geas::int_le(cp_->data, cp_var(x), cp_var(y), rhs, cp_var(r)));
 
     // Success.
     return true;
@@ -451,6 +477,9 @@ Model::add_constr_imply(
     const Int x_val
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(sign == Sign::EQ || sign == Sign::LE || sign == Sign::GE,
                    "Imply constraint only supports <=, == or >=");
@@ -507,11 +536,12 @@ Model::add_constr_imply(
     // Create constraint in CP.
     // r_lit -> x_lit
     // ~r_lit \/ x_lit
+    add_cp_scope({r}, {x});
     auto r_lit = r_val ? cp_var(r) : ~cp_var(r);
     auto x_lit = sign == Sign::EQ ? (cp_var(x) == x_val) :
                  sign == Sign::LE ? (cp_var(x) <= x_val) :
                                     (cp_var(x) >= x_val);
-    geas_add_constr(geas::add_clause(cp_.data, ~r_lit, x_lit));
+    geas_add_constr(geas::add_clause(cp_->data, ~r_lit, x_lit));
 
     // Success.
     return true;
@@ -523,9 +553,13 @@ Model::add_constr_cumulative(
     const Vector<Int>& duration,
     const Vector<Int>& resource,
     const Int capacity,
-    const bool create_mip_linearization
+    const bool create_mip_linearization,
+    const bool lazy_mip_linearization
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(start.size() == duration.size() &&
                    duration.size() == resource.size(),
@@ -553,41 +587,54 @@ Model::add_constr_cumulative(
                 l = ub(start[j]);
         }
 
-        // Create resource constraints.
-        for (Int t = e; t <= l; ++t)
+        // Create resource constraints. Only the CP subproblem enforces the constraint when solving using BC,
+        // so the time slices can instead be separated as cuts when the LP violates them.
+        if (lazy_mip_linearization && method_ == Method::BC)
         {
-            // Create constraint.
-            SCIP_CONS* cons = nullptr;
-            scip_assert(SCIPcreateConsBasicKnapsack(mip_,
-                                                    &cons,
-                                                    "",
-                                                    0,
-                                                    nullptr,
-                                                    nullptr,
-                                                    capacity));
-            debug_assert(cons);
+            if (!SCIPfindSepa(mip_, "cumulative"))
+            {
+                scip_assert(includeSepaCumulative(mip_));
+            }
+            probdata_->lazy_cumulatives_.push_back(CumulativeRelaxation{start, duration, resource, capacity, e, l});
+        }
+        else
+        {
+            for (Int t = e; t <= l; ++t)
+            {
+                // Create constraint.
+                SCIP_CONS* cons = nullptr;
+                scip_assert(SCIPcreateConsBasicKnapsack(mip_,
+                                                        &cons,
+                                                        "",
+                                                        0,
+                                                        nullptr,
+                                                        nullptr,
+                                                        capacity));
+                debug_assert(cons);
 
-            // Add variables to constraint.
-            for (Int j = 0; j < N; ++j)
-                if (resource[j] > 0 && duration[j] > 0)
-                {
-                    for (Int u = std::max(t - duration[j] + 1, lb(start[j]));
-                         u <= std::min(t, ub(start[j]));
-                         ++u)
+                // Add variables to constraint.
+                for (Int j = 0; j < N; ++j)
+                    if (resource[j] > 0 && duration[j] > 0)
                     {
-                        auto var = mip_indicator_var(start[j], u);
-                        debug_assert(var);
-                        SCIPaddCoefKnapsack(mip_, cons, var, resource[j]);
+                        for (Int u = std::max(t - duration[j] + 1, lb(start[j]));
+                             u <= std::min(t, ub(start[j]));
+                             ++u)
+                        {
+                            auto var = mip_indicator_var(start[j], u);
+                            debug_assert(var);
+                            SCIPaddCoefKnapsack(mip_, cons, var, resource[j]);
+                        }
                     }
-                }
 
-            // Add constraint.
-            scip_assert(SCIPaddCons(mip_, cons));
-            scip_assert(SCIPreleaseCons(mip_, &cons));
+                // Add constraint.
+                scip_assert(SCIPaddCons(mip_, cons));
+                scip_assert(SCIPreleaseCons(mip_, &cons));
+            }
         }
     }
 
     // Create constraint in CP.
+    add_cp_scope({}, start);
     {
         vec<geas::intvar> start2;
         vec<int> duration2;
@@ -602,7 +649,7 @@ Model::add_constr_cumulative(
                 resource2.push(resource[idx]);
             }
 
-        geas_add_constr(geas::cumulative(cp_.data,
+        geas_add_constr(geas::cumulative(cp_->data,
                                          start2,
                                          duration2,
                                          resource2,
@@ -623,6 +670,9 @@ Model::add_constr_cumulative_optional(
     const IntVar makespan
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(active.size() == start.size() &&
                    start.size() == duration.size() &&
@@ -801,6 +851,7 @@ Model::add_constr_cumulative_optional(
     }
 
     // Create constraint in CP.
+    add_cp_scope(active, start);
     {
         vec<geas::patom_t> active2(N);
         vec<geas::intvar> start2(N);
@@ -812,10 +863,10 @@ Model::add_constr_cumulative_optional(
                            "Variable is not valid in creating cumulative_optional constraint");
             active2[idx] = cp_var(active[idx]);
             start2[idx] = cp_var(start[idx]);
-            duration2[idx] = cp_.new_intvar(duration[idx], duration[idx]);
+            duration2[idx] = cp_->new_intvar(duration[idx], duration[idx]);
             resource2[idx] = resource[idx];
         }
-        geas_add_constr(geas::cumulative_sel(cp_.data,
+        geas_add_constr(geas::cumulative_sel(cp_->data,
                                              start2,
                                              duration2,
                                              resource2,
@@ -888,6 +939,16 @@ Model::add_constr_cumulative_optional(
         scip_assert(SCIPreleaseCons(mip_, &cons));
     }
 
+    // Separate energetic reasoning cuts over time windows.
+    if (method_ != Method::CP)
+    {
+        if (!SCIPfindSepa(mip_, "energetic"))
+        {
+            scip_assert(includeSepaEnergetic(mip_));
+        }
+        probdata_->energetic_cumulatives_.push_back(EnergeticRelaxation{active, start, duration, resource, capacity});
+    }
+
     // Success.
     return true;
 }
@@ -12,11 +12,14 @@ BoolVar Model::add_bool_var(
     const String& name    // Variable name
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Create variable object.
     BoolVar bool_var(this, nb_bool_vars());
 
     // Create variable in MIP.
-    SCIP_VAR*& mip_var = probdata_.mip_bool_vars_.emplace_back();
+    SCIP_VAR*& mip_var = probdata_->mip_bool_vars_.emplace_back();
     scip_assert(SCIPcreateVarBasic(mip_,
                                    &mip_var,
                                    name.c_str(),
@@ -26,18 +29,18 @@ BoolVar Model::add_bool_var(
                                    SCIP_VARTYPE_BINARY));
     release_assert(mip_var, "Failed to create Boolean variable in MIP");
     scip_assert(SCIPaddVar(mip_, mip_var));
-    probdata_.mip_neg_vars_idx_.emplace_back(-1);
+    probdata_->mip_neg_vars_idx_.emplace_back(-1);
 
     // Create variable in CP.
-    probdata_.cp_bool_vars_.push_back(cp_.new_boolvar());
+    probdata_->cp_bool_vars_.push_back(cp_->new_boolvar());
 
     // Store variable name.
-    probdata_.bool_vars_name_.emplace_back(name);
+    probdata_->bool_vars_name_.emplace_back(name);
 
     // Check.
-    debug_assert(probdata_.mip_bool_vars_.size() == probdata_.mip_neg_vars_idx_.size());
-    debug_assert(probdata_.mip_neg_vars_idx_.size() == probdata_.cp_bool_vars_.size());
-    debug_assert(probdata_.cp_bool_vars_.size() == probdata_.bool_vars_name_.size());
+    debug_assert(probdata_->mip_bool_vars_.size() == probdata_->mip_neg_vars_idx_.size());
+    debug_assert(probdata_->mip_neg_vars_idx_.size() == probdata_->cp_bool_vars_.size());
+    debug_assert(probdata_->cp_bool_vars_.size() == probdata_->bool_vars_name_.size());
 
     // Return.
     return bool_var;
@@ -50,6 +53,9 @@ IntVar Model::add_int_var(
     const String& name            // Variable name
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(lb <= ub,
                    "Failed to create integer variable with bounds {} and {}", lb, ub);
@@ -57,8 +63,8 @@ IntVar Model::add_int_var(
     // Retrieve existing variable if the new variable is a constant and already added.
     if (lb == ub)
     {
-        auto it = probdata_.constants_.find(lb);
-        if (it != probdata_.constants_.end())
+        auto it = probdata_->constants_.find(lb);
+        if (it != probdata_->constants_.end())
         {
             return it->second;
         }
@@ -68,7 +74,7 @@ IntVar Model::add_int_var(
     IntVar int_var(this, nb_int_vars());
 
     // Create variable in MIP.
-    SCIP_VAR*& mip_var = probdata_.mip_int_vars_.emplace_back();
+    SCIP_VAR*& mip_var = probdata_->mip_int_vars_.emplace_back();
     if (include_in_mip || method_ == Method::MIP)
     {
         scip_assert(SCIPcreateVarBasic(mip_,
@@ -81,30 +87,30 @@ IntVar Model::add_int_var(
         release_assert(mip_var, "Failed to create integer variable in MIP");
         scip_assert(SCIPaddVar(mip_, mip_var));
     }
-    probdata_.mip_indicator_vars_idx_.emplace_back();
+    probdata_->mip_indicator_vars_idx_.emplace_back();
 
     // Create variable in CP.
-    probdata_.cp_int_vars_.push_back(cp_.new_intvar(lb, ub));
+    probdata_->cp_int_vars_.push_back(cp_->new_intvar(lb, ub));
 
     // Store variable bounds.
-    probdata_.int_vars_lb_.push_back(lb);
-    probdata_.int_vars_ub_.push_back(ub);
+    probdata_->int_vars_lb_.push_back(lb);
+    probdata_->int_vars_ub_.push_back(ub);
 
     // Store variable name.
-    probdata_.int_vars_name_.emplace_back(name);
+    probdata_->int_vars_name_.emplace_back(name);
 
     // Add to set of constants.
     if (lb == ub)
     {
-        probdata_.constants_.insert({lb, int_var});
+        probdata_->constants_.insert({lb, int_var});
     }
 
     // Check.
-    debug_assert(probdata_.mip_int_vars_.size() == probdata_.mip_indicator_vars_idx_.size());
-    debug_assert(probdata_.mip_indicator_vars_idx_.size() == probdata_.cp_int_vars_.size());
-    debug_assert(probdata_.cp_int_vars_.size() == probdata_.int_vars_lb_.size());
-    debug_assert(probdata_.int_vars_lb_.size() == probdata_.int_vars_ub_.size());
-    debug_assert(probdata_.int_vars_ub_.size() == probdata_.int_vars_name_.size());
+    debug_assert(probdata_->mip_int_vars_.size() == probdata_->mip_indicator_vars_idx_.size());
+    debug_assert(probdata_->mip_indicator_vars_idx_.size() == probdata_->cp_int_vars_.size());
+    debug_assert(probdata_->cp_int_vars_.size() == probdata_->int_vars_lb_.size());
+    debug_assert(probdata_->int_vars_lb_.size() == probdata_->int_vars_ub_.size());
+    debug_assert(probdata_->int_vars_ub_.size() == probdata_->int_vars_name_.size());
 
     // Return.
     return int_var;
@@ -112,12 +118,15 @@ IntVar Model::add_int_var(
 
 IntVar Model::add_mip_var(IntVar var)
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(var.model == this, "Variable belongs to a different model");
     release_assert(0 <= var.idx && var.idx < nb_int_vars(), "Variable is invalid");
 
     // Add MIP variable.
-    SCIP_VAR*& mip_var = probdata_.mip_int_vars_[var.idx];
+    SCIP_VAR*& mip_var = probdata_->mip_int_vars_[var.idx];
     if (!mip_var)
     {
         // Add linking constraint if indicator variables already exist.
@@ -132,7 +141,7 @@ IntVar Model::add_mip_var(IntVar var)
         scip_assert(SCIPaddVar(mip_, mip_var));
 
         // Add linking constraint.
-        auto& indicator_vars_idx = probdata_.mip_indicator_vars_idx_[var.idx];
+        auto& indicator_vars_idx = probdata_->mip_indicator_vars_idx_[var.idx];
         if (!indicator_vars_idx.empty())
         {
             // Get the bounds.
@@ -143,7 +152,7 @@ IntVar Model::add_mip_var(IntVar var)
             // Create constraint.
             SCIP_CONS* cons = nullptr;
             const auto constr_name = fmt::format("indicator_vars_linking_{}",
-                                                 probdata_.nb_indicator_vars_linking_constraints_++);
+                                                 probdata_->nb_indicator_vars_linking_constraints_++);
             scip_assert(SCIPcreateConsBasicLinear(mip_,
                                                   &cons,
                                                   constr_name.c_str(),
@@ -161,7 +170,7 @@ IntVar Model::add_mip_var(IntVar var)
                 debug_assert(get_false().idx == 0);
                 if (var_idx > 0)
                 {
-                    auto var = probdata_.mip_bool_vars_[var_idx];
+                    auto var = probdata_->mip_bool_vars_[var_idx];
                     const auto val = var_lb + idx;
                     scip_assert(SCIPaddCoefLinear(mip_, cons, var, val));
                 }
@@ -185,7 +194,7 @@ IntVar Model::add_mip_var(IntVar var)
 //    release_assert(0 <= var.idx && var.idx < nb_bool_vars(), "Variable is invalid");
 //
 //    // Add MIP variable.
-//    SCIP_VAR*& mip_var = probdata_.mip_bool_vars_[var.idx];
+//    SCIP_VAR*& mip_var = probdata_->mip_bool_vars_[var.idx];
 //    if (!mip_var)
 //    {
 //        scip_assert(SCIPcreateVarBasic(mip_,
@@ -208,6 +217,9 @@ Vector<BoolVar> Model::add_indicator_vars(
     const Vector<Int>& domain
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(var.model == this, "Variable belongs to a different model");
     release_assert(0 <= var.idx && var.idx < nb_int_vars(), "Variable is invalid");
@@ -218,8 +230,8 @@ Vector<BoolVar> Model::add_indicator_vars(
     const auto size = var_ub - var_lb + 1;
 
     // Create indicator variables if not yet created.
-    debug_assert(var.idx < static_cast<Int>(probdata_.mip_indicator_vars_idx_.size()));
-    auto& indicator_vars_idx = probdata_.mip_indicator_vars_idx_[var.idx];
+    debug_assert(var.idx < static_cast<Int>(probdata_->mip_indicator_vars_idx_.size()));
+    auto& indicator_vars_idx = probdata_->mip_indicator_vars_idx_[var.idx];
     if (indicator_vars_idx.empty())
     {
         // Create complete domain if the input set is empty.
@@ -263,19 +275,19 @@ Vector<BoolVar> Model::add_indicator_vars(
             scip_assert(SCIPaddVar(mip_, ind_var));
             indicator_vars_idx[idx] = nb_bool_vars();
             indicator_vals[idx] = val;
-            probdata_.mip_bool_vars_.push_back(ind_var);
-            probdata_.mip_neg_vars_idx_.emplace_back(-1);
+            probdata_->mip_bool_vars_.push_back(ind_var);
+            probdata_->mip_neg_vars_idx_.emplace_back(-1);
 
             // Get literal in CP.
-            probdata_.cp_bool_vars_.push_back(cp_var(var) == val);
+            probdata_->cp_bool_vars_.push_back(cp_var(var) == val);
 
             // Store variable name.
-            probdata_.bool_vars_name_.push_back(move(ind_var_name));
+            probdata_->bool_vars_name_.push_back(move(ind_var_name));
 
             // Check.
-            debug_assert(probdata_.mip_bool_vars_.size() == probdata_.mip_neg_vars_idx_.size());
-            debug_assert(probdata_.mip_neg_vars_idx_.size() == probdata_.cp_bool_vars_.size());
-            debug_assert(probdata_.cp_bool_vars_.size() == probdata_.bool_vars_name_.size());
+            debug_assert(probdata_->mip_bool_vars_.size() == probdata_->mip_neg_vars_idx_.size());
+            debug_assert(probdata_->mip_neg_vars_idx_.size() == probdata_->cp_bool_vars_.size());
+            debug_assert(probdata_->cp_bool_vars_.size() == probdata_->bool_vars_name_.size());
         }
 
         // Fix values not in the domain.
@@ -283,7 +295,7 @@ Vector<BoolVar> Model::add_indicator_vars(
             if (!indicator_vars[idx])
             {
                 const auto val = var_lb + idx;
-                release_assert(cp_.post(cp_var(var) != val), "Internal error while creating indicator variables");
+                release_assert(cp_->post(cp_var(var) != val), "Internal error while creating indicator variables");
             }
 
         // Create set partition constraint.
@@ -291,7 +303,7 @@ Vector<BoolVar> Model::add_indicator_vars(
             // Create constraint.
             SCIP_CONS* cons = nullptr;
             const auto constr_name = fmt::format("indicator_vars_setpart_{}",
-                                                 probdata_.nb_indicator_vars_setpart_constraints_++);
+                                                 probdata_->nb_indicator_vars_setpart_constraints_++);
             scip_assert(SCIPcreateConsBasicSetpart(mip_,
                                                    &cons,
                                                    constr_name.c_str(),
@@ -317,7 +329,7 @@ Vector<BoolVar> Model::add_indicator_vars(
             // Create constraint.
             SCIP_CONS* cons = nullptr;
             const auto constr_name = fmt::format("indicator_vars_linking_{}",
-                                                 probdata_.nb_indicator_vars_linking_constraints_++);
+                                                 probdata_->nb_indicator_vars_linking_constraints_++);
             scip_assert(SCIPcreateConsBasicLinear(mip_,
                                                   &cons,
                                                   constr_name.c_str(),
@@ -358,6 +370,9 @@ void Model::add_mip_int_var_as_bool_var_alias(
     IntVar int_var
 )
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(int_var.model == this, "Integer variable belongs to a different model");
     release_assert(bool_var.model == this, "Boolean variable belongs to a different model");
@@ -370,19 +385,22 @@ void Model::add_mip_int_var_as_bool_var_alias(
 //                   SCIPvarGetStatus(mip_var(bool_var)));
 
     // Set integer variable to existing Boolean variable in MIP solver.
-    probdata_.mip_int_vars_[int_var.idx] = probdata_.mip_bool_vars_[bool_var.idx];
-    scip_assert(SCIPcaptureVar(mip_, probdata_.mip_int_vars_[int_var.idx]));
+    probdata_->mip_int_vars_[int_var.idx] = probdata_->mip_bool_vars_[bool_var.idx];
+    scip_assert(SCIPcaptureVar(mip_, probdata_->mip_int_vars_[int_var.idx]));
 }
 
 BoolVar Model::get_neg(const BoolVar var)
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     // Check.
     release_assert(var.model == this, "Variable belongs to a different model");
     release_assert(0 <= var.idx && var.idx < nb_bool_vars(), "Variable is invalid");
 
     // Get negated variable if already exists.
     const auto var_idx = var.idx;
-    if (const auto neg_idx = probdata_.mip_neg_vars_idx_[var_idx]; neg_idx >= 0)
+    if (const auto neg_idx = probdata_->mip_neg_vars_idx_[var_idx]; neg_idx >= 0)
     {
         return BoolVar(this, neg_idx);
     }
@@ -390,19 +408,19 @@ BoolVar Model::get_neg(const BoolVar var)
     // Create negated variable.
     const auto neg_idx = nb_bool_vars();
     BoolVar neg_var(this, neg_idx);
-    probdata_.mip_neg_vars_idx_[var_idx] = neg_idx;
-    probdata_.mip_neg_vars_idx_.emplace_back(var_idx);
-    probdata_.mip_bool_vars_.emplace_back();
+    probdata_->mip_neg_vars_idx_[var_idx] = neg_idx;
+    probdata_->mip_neg_vars_idx_.emplace_back(var_idx);
+    probdata_->mip_bool_vars_.emplace_back();
     scip_assert(SCIPgetNegatedVar(mip_,
-                                  probdata_.mip_bool_vars_[var_idx],
-                                  &probdata_.mip_bool_vars_.back()));
-    probdata_.cp_bool_vars_.emplace_back(~probdata_.cp_bool_vars_[var_idx]);
-    probdata_.bool_vars_name_.emplace_back("~" + probdata_.bool_vars_name_[var_idx]);
+                                  probdata_->mip_bool_vars_[var_idx],
+                                  &probdata_->mip_bool_vars_.back()));
+    probdata_->cp_bool_vars_.emplace_back(~probdata_->cp_bool_vars_[var_idx]);
+    probdata_->bool_vars_name_.emplace_back("~" + probdata_->bool_vars_name_[var_idx]);
 
     // Check.
-    debug_assert(probdata_.mip_bool_vars_.size() == probdata_.mip_neg_vars_idx_.size());
-    debug_assert(probdata_.mip_neg_vars_idx_.size() == probdata_.cp_bool_vars_.size());
-    debug_assert(probdata_.cp_bool_vars_.size() == probdata_.bool_vars_name_.size());
+    debug_assert(probdata_->mip_bool_vars_.size() == probdata_->mip_neg_vars_idx_.size());
+    debug_assert(probdata_->mip_neg_vars_idx_.size() == probdata_->cp_bool_vars_.size());
+    debug_assert(probdata_->cp_bool_vars_.size() == probdata_->bool_vars_name_.size());
 
     // Done.
     return neg_var;
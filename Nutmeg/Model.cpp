@@ -3,12 +3,24 @@
 #include "Model.h"
 #include "ConstraintHandler-Geas.h"
 #include "EventHandler-NewSolution.h"
+#include "Heuristic-CPRounding.h"
+#include "Heuristic-CPLNS.h"
+#include "BranchingRule-ConflictActivity.h"
+#include "Presolver-Probing.h"
+#include "Propagator-ObjectiveBound.h"
 #include "scip/scipdefplugins.h"
 #include "geas/vars/monitor.h"
+#include <mutex>
+#include <ctime>
 
 namespace Nutmeg
 {
 
+// Number of models alive in the process. SCIP's memory leak check inspects global state, so it can only
+// run once no other model holds SCIP memory.
+static std::mutex nb_models_mutex;
+static Int nb_models = 0;
+
 // Create problem data for transformed problem
 static
 SCIP_RETCODE callback_probtrans(
@@ -23,6 +35,9 @@ SCIP_RETCODE callback_probtrans(
     new(probdata) ProblemData(*reinterpret_cast<ProblemData*>(sourcedata));
     *targetdata = reinterpret_cast<SCIP_ProbData*>(probdata);
 
+    // Record only the nogoods found in the transformed problem. Earlier nogoods are already constraints.
+    probdata->nogoods_.clear();
+
     // Transform CP constraint.
     if (probdata->cp_cons_)
     {
@@ -51,6 +66,7 @@ SCIP_RETCODE callback_probtrans(
             {
                 debug_assert(probdata->bool_vars_name_[1] == "true");
                 var = probdata->mip_bool_vars_[1];
+                scip_assert(SCIPcaptureVar(scip, var));
             }
             else
             {
@@ -81,6 +97,9 @@ SCIP_RETCODE callback_probdeltrans(
         scip_assert(SCIPreleaseCons(scip, &probdata->cp_cons_));
     }
 
+    // Release nogoods.
+    scip_assert(probdata->nogood_pool_.release(scip));
+
     // Release variables.
     for (Int idx = 0; idx < probdata->nb_bool_vars(); ++idx)
         if (probdata->is_pos_var(idx))
@@ -105,10 +124,10 @@ SCIP_RETCODE callback_probdeltrans(
 Model::Model(const Method method) :
     method_(method),
     mip_(nullptr),
-    cp_(),
+    cp_(std::make_unique<geas::solver>()),
     print_new_solution_function_(),
 
-    probdata_(*this, cp_, sol_),
+    probdata_(std::make_unique<ProblemData>(*this, *cp_, sol_)),
     status_(Status::Unknown),
     obj_(std::numeric_limits<Float>::quiet_NaN()),
     obj_bound_(std::numeric_limits<Float>::quiet_NaN()),
@@ -123,6 +142,12 @@ Model::Model(const Method method) :
     println("Nutmeg is compiled in debug mode");
 #endif
 
+    // Register model.
+    {
+        std::lock_guard<std::mutex> lock(nb_models_mutex);
+        ++nb_models;
+    }
+
     // Create SCIP.
     scip_assert(SCIPcreate(&mip_));
 
@@ -133,12 +158,44 @@ Model::Model(const Method method) :
     scip_assert(SCIPsetIntParam(mip_, "parallel/maxnthreads", 1));
     scip_assert(SCIPsetIntParam(mip_, "lp/threads", 1));
 
+    // Measure time limits in wall clock time because CPU time is accumulated over every thread in the
+    // process, including those solving other models. The timer of the model uses the same clock.
+    scip_assert(SCIPsetIntParam(mip_, "timing/clocktype", SCIP_CLOCKTYPE_WALL));
+
     // Disable multiaggregate variables.
     scip_assert(SCIPsetBoolParam(mip_, "presolving/donotmultaggr", TRUE));
 
-    // Disable restarts.
+    // Disable restarts. With the Geas constraint handler, restart only when it finds enough nogoods early
+    // in the search and not when SCIP fixes enough variables at the root. The constraint handler keeps
+    // presolving/maxrestarts equal to constraints/geas/maxrestarts.
     scip_assert(SCIPsetIntParam(mip_, "presolving/maxrestarts", 0));
+    if (method_ == Method::BC)
+    {
+        scip_assert(SCIPsetRealParam(mip_, "presolving/restartfac", 1.0));
+        scip_assert(SCIPsetRealParam(mip_, "presolving/immrestartfac", 1.0));
+        scip_assert(SCIPsetRealParam(mip_, "presolving/subrestartfac", 1.0));
+        scip_assert(SCIPsetRealParam(mip_, "presolving/restartminred", 0.0));
+    }
+
+    // Include constraint handler for Geas, probing of Boolean variables in Geas, propagator for the
+    // objective bound proven by Geas, primal heuristics completing LP roundings and searching around the
+    // incumbent in Geas, and branching on variables active in nogoods from Geas.
+    if (method_ == Method::BC)
+    {
+        scip_assert(SCIPincludeConshdlrGeas(mip_));
+        scip_assert(includePresolProbing(mip_));
+        scip_assert(includePropObjectiveBound(mip_));
+        scip_assert(includeHeurCPRounding(mip_));
+        scip_assert(includeHeurCPLNS(mip_));
+        scip_assert(includeBranchruleConflictActivity(mip_));
+    }
 
+    // Create empty problem.
+    create_problem();
+}
+
+void Model::create_problem()
+{
     // Create problem.
     scip_assert(SCIPcreateProbBasic(mip_, "Nutmeg"));
 
@@ -149,12 +206,12 @@ Model::Model(const Method method) :
     scip_assert(SCIPsetObjIntegral(mip_));
 
     // Create problem data.
-    scip_assert(SCIPsetProbData(mip_, reinterpret_cast<SCIP_ProbData*>(&probdata_)));
+    scip_assert(SCIPsetProbData(mip_, reinterpret_cast<SCIP_ProbData*>(probdata_.get())));
 
     // Create variable representing false.
     {
         // Create variable in MIP.
-        SCIP_VAR*& mip_var = probdata_.mip_bool_vars_.emplace_back();
+        SCIP_VAR*& mip_var = probdata_->mip_bool_vars_.emplace_back();
         scip_assert(SCIPcreateVarBasic(mip_,
                                        &mip_var,
                                        "false",
@@ -164,59 +221,58 @@ Model::Model(const Method method) :
                                        SCIP_VARTYPE_BINARY));
         release_assert(mip_var, "Failed to create Boolean variable in MIP");
         scip_assert(SCIPaddVar(mip_, mip_var));
-        probdata_.mip_neg_vars_idx_.emplace_back(1);
+        probdata_->mip_neg_vars_idx_.emplace_back(1);
 
         // Create variable in CP.
-        probdata_.cp_bool_vars_.push_back(geas::at_False);
+        probdata_->cp_bool_vars_.push_back(geas::at_False);
 
         // Store variable name.
-        probdata_.bool_vars_name_.emplace_back("false");
+        probdata_->bool_vars_name_.emplace_back("false");
     }
 
     // Create variable representing true.
     {
         // Create variable in MIP.
-        probdata_.mip_bool_vars_.emplace_back();
+        probdata_->mip_bool_vars_.emplace_back();
         scip_assert(SCIPgetNegatedVar(mip_,
-                                      probdata_.mip_bool_vars_[0],
-                                      &probdata_.mip_bool_vars_.back()));
-        probdata_.mip_neg_vars_idx_.emplace_back(0);
+                                      probdata_->mip_bool_vars_[0],
+                                      &probdata_->mip_bool_vars_.back()));
+        probdata_->mip_neg_vars_idx_.emplace_back(0);
 
         // Create variable in CP.
-        probdata_.cp_bool_vars_.push_back(geas::at_True);
+        probdata_->cp_bool_vars_.push_back(geas::at_True);
 
         // Store variable name.
-        probdata_.bool_vars_name_.emplace_back("true");
+        probdata_->bool_vars_name_.emplace_back("true");
     }
 
     // Create variable representing 0.
     {
         // Copy FALSE Boolean variable in MIP.
-        SCIP_VAR*& mip_var = probdata_.mip_int_vars_.emplace_back(probdata_.mip_bool_vars_[0]);
+        SCIP_VAR*& mip_var = probdata_->mip_int_vars_.emplace_back(probdata_->mip_bool_vars_[0]);
         scip_assert(SCIPcaptureVar(mip_, mip_var));
-        probdata_.mip_indicator_vars_idx_.emplace_back();
+        probdata_->mip_indicator_vars_idx_.emplace_back();
 
         // Create variable in CP.
-        probdata_.cp_int_vars_.push_back(cp_.new_intvar(0, 0));
+        probdata_->cp_int_vars_.push_back(cp_->new_intvar(0, 0));
 
         // Store variable data.
-        probdata_.int_vars_lb_.push_back(0);
-        probdata_.int_vars_ub_.push_back(0);
-        probdata_.int_vars_name_.emplace_back("0");
+        probdata_->int_vars_lb_.push_back(0);
+        probdata_->int_vars_ub_.push_back(0);
+        probdata_->int_vars_name_.emplace_back("0");
 
         // Set as objective variable.
-        probdata_.obj_var_idx_ = 0;
+        probdata_->obj_var_idx_ = 0;
 
         // Add to set of constants.
-        probdata_.constants_.insert({0, IntVar(this, 0)});
+        probdata_->constants_.insert({0, IntVar(this, 0)});
     }
 
-    // Create constraint handler for Geas.
+    // Create constraint for Geas.
     if (method_ == Method::BC)
     {
-        scip_assert(SCIPincludeConshdlrGeas(mip_));
-        scip_assert(SCIPcreateConsBasicGeas(mip_, &probdata_.cp_cons_, "Geas"));
-        scip_assert(SCIPaddCons(mip_, probdata_.cp_cons_));
+        scip_assert(SCIPcreateConsBasicGeas(mip_, &probdata_->cp_cons_, "Geas"));
+        scip_assert(SCIPaddCons(mip_, probdata_->cp_cons_));
     }
 
     // Linearize linking constraints for binarized variables.
@@ -227,35 +283,178 @@ Model::Model(const Method method) :
     scip_assert(SCIPsetProbDeltrans(mip_, callback_probdeltrans));
 }
 
-Model::~Model()
+void Model::free_problem()
 {
-    // Free problem data.
+    // Release CP constraint handler.
+    if (probdata_->cp_cons_)
     {
-        // Release CP constraint handler.
-        if (probdata_.cp_cons_)
+        scip_assert(SCIPreleaseCons(mip_, &probdata_->cp_cons_));
+    }
+
+    // Release variables.
+    for (Int idx = 0; idx < probdata_->nb_bool_vars(); ++idx)
+        if (probdata_->is_pos_var(idx))
+        {
+            auto& var = probdata_->mip_bool_vars_[idx];
+            scip_assert(SCIPreleaseVar(mip_, &var));
+        }
+    for (auto& var : probdata_->mip_int_vars_)
+        if (var)
         {
-            scip_assert(SCIPreleaseCons(mip_, &probdata_.cp_cons_));
+            scip_assert(SCIPreleaseVar(mip_, &var));
         }
+}
 
-        // Release variables.
-        for (Int idx = 0; idx < probdata_.nb_bool_vars(); ++idx)
-            if (probdata_.is_pos_var(idx))
-            {
-                auto& var = probdata_.mip_bool_vars_[idx];
-                scip_assert(SCIPreleaseVar(mip_, &var));
-            }
-        for (auto& var : probdata_.mip_int_vars_)
-            if (var)
-            {
-                scip_assert(SCIPreleaseVar(mip_, &var));
-            }
+void Model::reopen_problem()
+{
+    // Nothing to undo before the first solve.
+    if (SCIPgetStage(mip_) == SCIP_STAGE_PROBLEM)
+    {
+        return;
+    }
+
+    // Get the nogoods found in the transformed problem. Nogoods are implied by the CP subproblem, which
+    // only becomes tighter as constraints are added, so they stay valid.
+    const auto nogoods = get_trans_nogoods();
+
+    // Free the transformed problem. The CP solver keeps its learned clauses.
+    cp_->clear_assumptions();
+    scip_assert(SCIPfreeTransform(mip_));
+
+    // Add the nogoods to the original problem.
+    for (const auto& nogood : nogoods)
+    {
+        add_original_nogood(nogood);
+    }
+
+    // Replace the solution hints by the incumbent, and clear the incumbent because it can be infeasible
+    // after the change.
+    probdata_->bool_vars_hint_.clear();
+    probdata_->int_vars_hint_.clear();
+    if (status_ == Status::Optimal || status_ == Status::Feasible)
+    {
+        add_solution_hint(sol_);
+    }
+    sol_ = Solution();
+
+    // Clear the result. An infeasible model stays infeasible after adding constraints.
+    if (status_ != Status::Infeasible)
+    {
+        status_ = Status::Unknown;
+    }
+    obj_ = std::numeric_limits<Float>::quiet_NaN();
+    obj_bound_ = std::numeric_limits<Float>::quiet_NaN();
+}
+
+void Model::reset()
+{
+    // Free the problem in SCIP but keep SCIP and its plugins.
+    free_problem();
+    scip_assert(SCIPfreeProb(mip_));
+
+    // Restore the parameters changed by solving.
+    scip_assert(SCIPresetParam(mip_, "display/verblevel"));
+    scip_assert(SCIPresetParam(mip_, "limits/time"));
+
+    // Replace the CP solver and the problem data. The problem data holds a reference to the CP solver, so
+    // it is destroyed first.
+    probdata_.reset();
+    cp_ = std::make_unique<geas::solver>();
+    probdata_ = std::make_unique<ProblemData>(*this, *cp_, sol_);
+
+    // Clear the solution. The event handler for new solutions stays included in SCIP, so the print
+    // function is replaced rather than removed.
+    if (print_new_solution_function_)
+    {
+        print_new_solution_function_ = []() {};
     }
+    status_ = Status::Unknown;
+    obj_ = std::numeric_limits<Float>::quiet_NaN();
+    obj_bound_ = std::numeric_limits<Float>::quiet_NaN();
+    sol_ = Solution();
+    time_limit_ = 0;
+    start_time_ = 0;
+    run_time_ = 0;
+
+    // Create empty problem.
+    create_problem();
+}
+
+Model::~Model()
+{
+    // Free problem data.
+    free_problem();
 
     // Destroy SCIP.
     scip_assert(SCIPfree(&mip_));
 
-    // Check if memory is leaked.
-    BMScheckEmptyMemory();
+    // Check if memory is leaked once the last model is destroyed.
+    {
+        std::lock_guard<std::mutex> lock(nb_models_mutex);
+        --nb_models;
+        debug_assert(nb_models >= 0);
+        if (nb_models == 0)
+        {
+            BMScheckEmptyMemory();
+        }
+    }
+}
+
+void Model::add_solution_hint(const BoolVar var, const bool val)
+{
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
+    // Check.
+    release_assert(var.model == this, "Variable belongs to a different model");
+    release_assert(0 <= var.idx && var.idx < nb_bool_vars(), "Variable is invalid");
+
+    // Store hint. The constant variables need no hint.
+    if (var.idx >= 2)
+    {
+        probdata_->bool_vars_hint_.emplace_back(var.idx, val);
+    }
+}
+
+void Model::add_solution_hint(const IntVar var, const Int val)
+{
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
+    // Check.
+    release_assert(var.model == this, "Variable belongs to a different model");
+    release_assert(0 <= var.idx && var.idx < nb_int_vars(), "Variable is invalid");
+    release_assert(lb(var) <= val && val <= ub(var),
+                   "Hint {} for variable {} is outside its domain [{}, {}]", val, name(var), lb(var), ub(var));
+
+    // Store hint. The constant zero needs no hint.
+    if (var.idx >= 1)
+    {
+        probdata_->int_vars_hint_.emplace_back(var.idx, val);
+    }
+}
+
+void Model::add_solution_hint(const Solution& sol)
+{
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
+    // Check.
+    release_assert(static_cast<Int>(sol.bool_vars_sol_.size()) == nb_bool_vars() &&
+                   static_cast<Int>(sol.int_vars_sol_.size()) == nb_int_vars(),
+                   "Solution has {} Boolean and {} integer variables but the model has {} and {}",
+                   sol.bool_vars_sol_.size(), sol.int_vars_sol_.size(), nb_bool_vars(), nb_int_vars());
+
+    // Store hints. Integer variables without a value in the solution are skipped.
+    for (Int idx = 2; idx < nb_bool_vars(); ++idx)
+    {
+        add_solution_hint(BoolVar(this, idx), sol.bool_vars_sol_[idx]);
+    }
+    for (Int idx = 1; idx < nb_int_vars(); ++idx)
+        if (const auto val = sol.int_vars_sol_[idx]; val != std::numeric_limits<Int>::max())
+        {
+            add_solution_hint(IntVar(this, idx), val);
+        }
 }
 
 void Model::add_print_new_solution_function(std::function<void()> print_new_solution_function)
@@ -273,6 +472,9 @@ void Model::add_print_new_solution_function(std::function<void()> print_new_solu
 
 void Model::minimize(const IntVar obj_var, const Float time_limit, const bool verbose)
 {
+    // Return to the original problem if the model was solved.
+    reopen_problem();
+
     if (method_ == Method::BC)
     {
         minimize_using_bc(obj_var, time_limit, verbose);
@@ -344,18 +546,26 @@ void Model::start_timer(const Float time_limit)
 {
     release_assert(time_limit > 0, "Time limit {} is invalid", time_limit);
     time_limit_ = time_limit;
-    start_time_ = clock();
+    start_time_ = get_wall_clock_time();
+}
+
+Float Model::get_wall_clock_time()
+{
+    // Measure wall clock time, as SCIP does, so that the time limits checked by Nutmeg and by SCIP agree
+    // and other models solving concurrently in the same process are not counted.
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<Float>(time.tv_sec) + static_cast<Float>(time.tv_nsec) * 1e-9;
 }
 
-Float Model::get_cpu_time() const
+Float Model::get_time_elapsed() const
 {
-    const auto current_time = clock();
-    return static_cast<Float>(current_time - start_time_) / CLOCKS_PER_SEC;
+    return get_wall_clock_time() - start_time_;
 }
 
 Float Model::get_time_remaining() const
 {
-    return time_limit_ - get_cpu_time();
+    return time_limit_ - get_time_elapsed();
 }
 
 void Model::write_lp()
@@ -5,6 +5,7 @@
 #include "Variable.h"
 #include "ProblemData.h"
 #include "Solution.h"
+#include <memory>
 
 namespace Nutmeg
 {
@@ -16,6 +17,12 @@ enum class Sign
     GE,
 };
 
+enum class ElementFormulation
+{
+    Indicator,
+    ConvexHull
+};
+
 enum class Method
 {
     BC,
@@ -38,11 +45,11 @@ class Model
     // Solvers
     Method method_;
     SCIP* mip_;
-    geas::solver cp_;
+    std::unique_ptr<geas::solver> cp_;
     std::function<void()> print_new_solution_function_;
 
     // Problem
-    ProblemData probdata_;
+    std::unique_ptr<ProblemData> probdata_;
     Status status_;
     Float obj_;
     Float obj_bound_;
@@ -50,7 +57,7 @@ class Model
 
     // Timer
     Float time_limit_;
-    clock_t start_time_;
+    Float start_time_;
     Float run_time_;
 
   public:
@@ -64,11 +71,18 @@ class Model
     Model& operator=(Model&& model) = delete;
     ~Model();
 
+    // Clear the model to an empty problem, keeping SCIP and its plugins to skip their initialization on
+    // the next solve. Existing variables become invalid. The parameters set by solving, display/verblevel
+    // and limits/time, return to their defaults. Every other SCIP parameter keeps its value, including
+    // those set by the constructor and those changed by the user through mip().
+    void reset();
+
     // Get solver internal data
     // ------------------------
-    inline geas::solver_data*& cp_data() { return cp_.data; }
-    inline geas::solver& cp() { return cp_; }
+    inline geas::solver_data*& cp_data() { return cp_->data; }
+    inline geas::solver& cp() { return *cp_; }
     inline SCIP* mip() { return mip_; }
+    inline Method method() const { return method_; }
     inline void mark_as_infeasible() { status_ = Status::Infeasible; }
 
     // Create variables
@@ -85,12 +99,12 @@ class Model
 
     // Functions to get variables
     // --------------------------
-    inline Int nb_bool_vars() const { return probdata_.nb_bool_vars(); };
-    inline Int nb_int_vars() const { return probdata_.nb_int_vars(); };
-    inline Int lb(const IntVar var) const { return probdata_.lb(var); }
-    inline Int ub(const IntVar var) const { return probdata_.ub(var); }
-    inline const String& name(const BoolVar var) const { return probdata_.name(var); }
-    inline const String& name(const IntVar var) const { return probdata_.name(var); }
+    inline Int nb_bool_vars() const { return probdata_->nb_bool_vars(); };
+    inline Int nb_int_vars() const { return probdata_->nb_int_vars(); };
+    inline Int lb(const IntVar var) const { return probdata_->lb(var); }
+    inline Int ub(const IntVar var) const { return probdata_->ub(var); }
+    inline const String& name(const BoolVar var) const { return probdata_->name(var); }
+    inline const String& name(const IntVar var) const { return probdata_->name(var); }
     BoolVar get_neg(const BoolVar var);
     inline BoolVar get_false() { return BoolVar(this, 0); }
     inline BoolVar get_true() { return BoolVar(this, 1); }
@@ -98,24 +112,29 @@ class Model
     
     // Functions to get internal variables data
     // ----------------------------------------
-    inline SCIP_VAR* mip_var(const BoolVar var) const { return probdata_.mip_var(var); }
-    inline SCIP_VAR* mip_var(const IntVar var) const { return probdata_.mip_var(var); }
-    inline bool is_pos_var(const BoolVar var) const { return probdata_.is_pos_var(var); }
-    inline bool has_mip_indicator_vars(const IntVar var) const { return probdata_.has_mip_indicator_vars(var); }
-    inline SCIP_VAR* mip_indicator_var(const IntVar var, const Int k) const { return probdata_.mip_indicator_var(var, k); }
-    inline geas::patom_t cp_var(const BoolVar var) const { return probdata_.cp_var(var); }
-    inline geas::intvar cp_var(const IntVar var) const { return probdata_.cp_var(var); }
+    inline SCIP_VAR* mip_var(const BoolVar var) const { return probdata_->mip_var(var); }
+    inline SCIP_VAR* mip_var(const IntVar var) const { return probdata_->mip_var(var); }
+    inline bool is_pos_var(const BoolVar var) const { return probdata_->is_pos_var(var); }
+    inline bool has_mip_indicator_vars(const IntVar var) const { return probdata_->has_mip_indicator_vars(var); }
+    inline SCIP_VAR* mip_indicator_var(const IntVar var, const Int k) const { return probdata_->mip_indicator_var(var, k); }
+    inline geas::patom_t cp_var(const BoolVar var) const { return probdata_->cp_var(var); }
+    inline geas::intvar cp_var(const IntVar var) const { return probdata_->cp_var(var); }
 
     // Functions to get internal constraints data
     // ------------------------------------------
-    inline Int& nb_linear_constraints() { return probdata_.nb_linear_constraints_; }
-    inline Int& nb_indicator_constraints() { return probdata_.nb_indicator_constraints_; }
+    inline Int& nb_linear_constraints() { return probdata_->nb_linear_constraints_; }
+    inline Int& nb_indicator_constraints() { return probdata_->nb_indicator_constraints_; }
 
     // Create constraints
     // ------------------
     // Fix variable to true
     bool add_constr_fix(const BoolVar var);
 
+    // new_lb <= var <= new_ub
+    // The declared domain of the variable is unchanged, so the MIP formulations of later constraints stay
+    // valid but can be weaker than for a variable created with the new bounds.
+    bool add_constr_bounds(const IntVar var, const Int new_lb, const Int new_ub);
+
     // coeff[0] * vars[0] + ... + coeffs[n-1] * vars[n-1] <= / == / >= rhs
     bool add_constr_linear(const Vector<IntVar>& vars,
                            const Vector<Int>& coeffs,
@@ -128,12 +147,27 @@ class Model
                                const Int rhs);
 
     // var == array[idx]
-    bool add_constr_element(const IntVar& idx_var, const Vector<Int>& array, const IntVar& val_var);
-    bool add_constr_element(const IntVar& idx_var, const Vector<IntVar>& array, const IntVar& val_var);
+    // The MIP formulation is either a pair of indicator constraints per index or the convex hull over the
+    // indicator variables of the index.
+    bool add_constr_element(const IntVar& idx_var,
+                            const Vector<Int>& array,
+                            const IntVar& val_var,
+                            const ElementFormulation formulation = ElementFormulation::Indicator);
+    bool add_constr_element(const IntVar& idx_var,
+                            const Vector<IntVar>& array,
+                            const IntVar& val_var,
+                            const ElementFormulation formulation = ElementFormulation::Indicator);
 
     // alldifferent(vars)
     bool add_constr_alldifferent(const Vector<IntVar>& vars);
 
+    // Declare the columns interchangeable, i.e., swapping the variables of any two columns maps every
+    // solution to a solution with the same objective value, and variables outside the columns are
+    // unchanged by the swap. bool_vars[col][row] and int_vars[col][row] are the variables of a column.
+    // The MIP orders the columns of Boolean variables by an orbitope and every nogood is copied to the
+    // columns it could have been found in.
+    bool add_symmetry(const Vector<Vector<BoolVar>>& bool_vars, const Vector<Vector<IntVar>>& int_vars = {});
+
     // Create constraints (unchecked)
     // ------------------------------
     // coeff[0] * vars[0] + ... + coeffs[n-1] * vars[n-1] <= / == / >= rhs + rhs_coeff * rhs_var
@@ -173,11 +207,14 @@ class Model
                           const Int x_val);
 
     // cumulative(start, duration, resource, capacity)
+    // The MIP linearization adds one knapsack row per time point, or separates them on demand if lazy
+    // when solving using BC.
     bool add_constr_cumulative(const Vector<IntVar>& start,
                                const Vector<Int>& duration,
                                const Vector<Int>& resource,
                                const Int capacity,
-                               const bool create_mip_linearization = false);
+                               const bool create_mip_linearization = false,
+                               const bool lazy_mip_linearization = false);
 
     // cumulative(start, duration, [resource[i] * active[i] for all i], capacity)
     // start[i] + duration[i] <= makespan for all i
@@ -188,8 +225,34 @@ class Model
                                         const Int capacity,
                                         const IntVar makespan = {});
 
+    // Solution hints
+    // --------------
+    // Suggest values for a start solution. Before solving, the CP solver tries to extend the hints to a
+    // solution of the CP subproblem. The extension, or the hints themselves if none is found, are given to
+    // SCIP as a partial solution, which its completion heuristic may or may not turn into an incumbent.
+    // The hints also guide the CP rounding heuristic. Hints must lie within the bounds of the variables.
+    void add_solution_hint(const BoolVar var, const bool val);
+    void add_solution_hint(const IntVar var, const Int val);
+    // Suggest every value of a solution of a model with the same variables, such as the last solution
+    // of this model before it was changed
+    void add_solution_hint(const Solution& sol);
+
+    // Nogoods
+    // -------
+    // Write the nogoods learned from the CP subproblem to a file, one disjunction of variable bounds per
+    // line. Variables are identified by name, or by index if they have no usable name, so the file can
+    // be read into a model of a related instance built by the same code.
+    void export_nogoods(const String& file_path);
+    // Read nogoods from a file into the model as initial constraints, after the model is built. Only
+    // nogoods over variables in the MIP that the CP solver proves valid in this model are added. Returns
+    // the number of nogoods added.
+    Int import_nogoods(const String& file_path);
+
     // Solve
     // -----
+    // After solving, the model can be changed by adding variables and constraints and then solved again.
+    // The nogoods from the CP subproblem, the clauses learned by the CP solver and the incumbent, if it
+    // is still feasible, are kept.
     void add_print_new_solution_function(std::function<void()> print_new_solution_function);
     void satisfy(const Float time_limit = Infinity, const bool verbose = true) { minimize(get_zero(), time_limit, verbose); }
     void minimize(const IntVar obj_var, const Float time_limit = Infinity, const bool verbose = true);
@@ -203,15 +266,32 @@ class Model
     Int get_primal_bound() const;
     bool get_sol(const BoolVar var);
     Int get_sol(const IntVar var);
+    inline const Solution& get_solution() const { return sol_; }
 
     // Debug
     // -----
     void write_lp();
 
   private:
+    // Problem
+    // -------
+    void create_problem();
+    void free_problem();
+    void reopen_problem();
+
+    // Nogoods
+    // -------
+    Vector<NogoodData> get_trans_nogoods();
+    void add_original_nogood(const NogoodData& nogood);
+
+    // Constraints
+    // -----------
+    void add_cp_scope(const Vector<BoolVar>& bool_vars, const Vector<IntVar>& int_vars);
+
     // Solve
     // -----
     void minimize_using_bc(const IntVar obj_var, const Float time_limit, const bool verbose);
+    void add_solution_hints_to_mip(const Float time_limit);
     void minimize_using_lbbd(const IntVar obj_var, const Float time_limit, const bool verbose);
     void minimize_using_mip(const IntVar obj_var, const Float time_limit, const bool verbose);
     void minimize_using_cp(const IntVar obj_var, const Float time_limit, const bool verbose);
@@ -219,7 +299,8 @@ class Model
     // Timer
     // -----
     void start_timer(const Float time_limit);
-    Float get_cpu_time() const;
+    static Float get_wall_clock_time();
+    Float get_time_elapsed() const;
     Float get_time_remaining() const;
 };
 
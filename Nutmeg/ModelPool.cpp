@@ -0,0 +1,41 @@
+#include "ModelPool.h"
+
+namespace Nutmeg
+{
+
+std::unique_ptr<Model> ModelPool::acquire(const Method method)
+{
+    // Take an idle model using the same method.
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = models_.begin(); it != models_.end(); ++it)
+            if ((*it)->method() == method)
+            {
+                auto model = std::move(*it);
+                models_.erase(it);
+                return model;
+            }
+    }
+
+    // Create a new model if none is idle.
+    return std::make_unique<Model>(method);
+}
+
+void ModelPool::release(std::unique_ptr<Model> model)
+{
+    // Reset outside of the lock since it can be slow.
+    release_assert(model, "Cannot give back an empty model");
+    model->reset();
+
+    // Store the model.
+    std::lock_guard<std::mutex> lock(mutex_);
+    models_.push_back(std::move(model));
+}
+
+Int ModelPool::nb_idle_models()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return models_.size();
+}
+
+}
@@ -0,0 +1,43 @@
+#ifndef NUTMEG_MODELPOOL_H
+#define NUTMEG_MODELPOOL_H
+
+#include "Includes.h"
+#include "Model.h"
+#include <memory>
+#include <mutex>
+
+namespace Nutmeg
+{
+
+// Hands out models for repeated solves. Models given back to the pool are reset to an empty problem
+// and reused, so SCIP and its plugins are initialized once per model instead of once per solve. SCIP
+// parameters changed on a model other than display/verblevel and limits/time survive the release and
+// apply to the next solve of the model, so callers changing them must restore them before release.
+class ModelPool
+{
+    std::mutex mutex_;
+    Vector<std::unique_ptr<Model>> models_;
+
+  public:
+    // Constructors
+    // ------------
+    ModelPool() = default;
+    ModelPool(const ModelPool& pool) = delete;
+    ModelPool(ModelPool&& pool) = delete;
+    ModelPool& operator=(const ModelPool& pool) = delete;
+    ModelPool& operator=(ModelPool&& pool) = delete;
+    ~ModelPool() = default;
+
+    // Get an empty model, reusing an idle one if available
+    std::unique_ptr<Model> acquire(const Method method = Method::BC);
+
+    // Give back a model to be reused
+    void release(std::unique_ptr<Model> model);
+
+    // Get the number of idle models
+    Int nb_idle_models();
+};
+
+}
+
+#endif
@@ -0,0 +1,398 @@
+//#define PRINT_DEBUG
+
+#include "NogoodPool.h"
+#include "scip/cons_logicor.h"
+#include "scip/cons_bounddisjunction.h"
+#include <algorithm>
+
+#define NOGOOD_DORMANT_AGE                            1000 // age of the constraint of a nogood after which the nogood becomes dormant
+#define NOGOOD_AGING_INTERVAL                          100 // number of nogoods added between checks of the ages
+
+namespace Nutmeg
+{
+
+// Get the signature of a nogood by setting one bit for each variable and sign
+static uint64_t get_signature(const NogoodData& nogood)
+{
+    uint64_t signature = 0;
+    for (size_t idx = 0; idx < nogood.vars.size(); ++idx)
+    {
+        auto key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(nogood.vars[idx]));
+        key = (2 * key + (nogood.signs[idx] == SCIP_BOUNDTYPE_LOWER)) * 0x9E3779B97F4A7C15ull;
+        signature |= uint64_t{1} << (key >> 58);
+    }
+    return signature;
+}
+
+// Check if every bound of nogood a implies a bound of nogood b, so that b is redundant given a
+static bool subsumes(
+    const NogoodData& a,
+    const uint64_t a_signature,
+    const NogoodData& b,
+    const uint64_t b_signature
+)
+{
+    if (a.vars.size() > b.vars.size() || (a_signature & ~b_signature) != 0)
+    {
+        return false;
+    }
+    for (size_t a_idx = 0; a_idx < a.vars.size(); ++a_idx)
+    {
+        bool is_implied = false;
+        for (size_t b_idx = 0; b_idx < b.vars.size() && !is_implied; ++b_idx)
+            if (a.vars[a_idx] == b.vars[b_idx] && a.signs[a_idx] == b.signs[b_idx])
+            {
+                is_implied = a.signs[a_idx] == SCIP_BOUNDTYPE_LOWER ?
+                             a.bounds[a_idx] >= b.bounds[b_idx] :
+                             a.bounds[a_idx] <= b.bounds[b_idx];
+            }
+        if (!is_implied)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+NogoodPool::NogoodPool() noexcept :
+    nogoods_(),
+    free_idx_(),
+    occurrences_(),
+    nb_added_since_aging_(0)
+{
+}
+
+SCIP_RETCODE NogoodPool::add(SCIP* scip, const NogoodData& nogood, NogoodPoolResult& pool_result, SCIP_CONS*& cons)
+{
+    // Check.
+    debug_assert(nogood.vars.size() >= 2);
+    const auto signature = get_signature(nogood);
+
+    // Find a nogood subsuming the nogood, dropping those whose constraints were deleted by SCIP. Reviving
+    // such a constraint would duplicate the constraint SCIP replaced it with.
+    Int subsuming_idx;
+    while ((subsuming_idx = find_subsuming(nogood, signature)) >= 0 &&
+           SCIPconsIsDeleted(nogoods_[subsuming_idx].cons))
+    {
+        SCIP_CALL(erase(scip, subsuming_idx));
+    }
+
+    // Return the constraint of the subsuming nogood instead of adding the nogood. A dormant nogood is
+    // reactivated.
+    if (subsuming_idx >= 0)
+    {
+        auto& pooled = nogoods_[subsuming_idx];
+        if (pooled.is_active)
+        {
+            debugln("   Nogood is subsumed by an active nogood");
+            pool_result = NogoodPoolResult::Subsumed;
+        }
+        else
+        {
+            debugln("   Reactivating dormant nogood subsuming the nogood");
+            SCIP_CALL(activate(scip, pooled));
+            pool_result = NogoodPoolResult::Reactivated;
+        }
+        cons = pooled.cons;
+        return SCIP_OKAY;
+    }
+
+    // Disable and remove the nogoods subsumed by the nogood. They contain every variable and sign of the
+    // nogood, so only the shortest occurrence list of its bounds needs to be searched.
+    const Vector<Int>* candidates = nullptr;
+    for (size_t idx = 0; idx < nogood.vars.size(); ++idx)
+    {
+        const auto& occurrences = occurrences_[nogood.signs[idx]];
+        const auto it = occurrences.find(nogood.vars[idx]);
+        if (it == occurrences.end())
+        {
+            candidates = nullptr;
+            break;
+        }
+        if (!candidates || it->second.size() < candidates->size())
+        {
+            candidates = &it->second;
+        }
+    }
+    Vector<Int> subsumed;
+    if (candidates)
+    {
+        for (const auto idx : *candidates)
+            if (subsumes(nogood, signature, nogoods_[idx].nogood, nogoods_[idx].signature))
+            {
+                subsumed.push_back(idx);
+            }
+    }
+    for (const auto idx : subsumed)
+    {
+        if (nogoods_[idx].is_active && !SCIPconsIsDeleted(nogoods_[idx].cons))
+        {
+            SCIP_CALL(deactivate(scip, nogoods_[idx]));
+        }
+        SCIP_CALL(erase(scip, idx));
+    }
+    debugln("   Removing {} nogoods subsumed by the nogood", subsumed.size());
+
+    // Add the nogood.
+    auto& pooled = nogoods_[insert(PooledNogood{nogood, signature, nullptr, false})];
+    SCIP_CALL(activate(scip, pooled));
+    pool_result = NogoodPoolResult::Added;
+    cons = pooled.cons;
+
+    // Age the nogoods periodically.
+    if (++nb_added_since_aging_ >= NOGOOD_AGING_INTERVAL)
+    {
+        SCIP_CALL(age(scip));
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+Int NogoodPool::find_subsuming(const NogoodData& nogood, const uint64_t signature) const
+{
+    // Count the bounds of each nogood that share a variable and sign with the nogood. A subsuming nogood
+    // shares all of its bounds.
+    HashTable<Int, Int> nb_shared;
+    for (size_t idx = 0; idx < nogood.vars.size(); ++idx)
+    {
+        const auto& occurrences = occurrences_[nogood.signs[idx]];
+        if (const auto it = occurrences.find(nogood.vars[idx]); it != occurrences.end())
+            for (const auto pooled_idx : it->second)
+            {
+                ++nb_shared[pooled_idx];
+            }
+    }
+    for (const auto [pooled_idx, count] : nb_shared)
+    {
+        const auto& pooled = nogoods_[pooled_idx];
+        if (count == static_cast<Int>(pooled.nogood.vars.size()) &&
+            subsumes(pooled.nogood, pooled.signature, nogood, signature))
+        {
+            return pooled_idx;
+        }
+    }
+    return -1;
+}
+
+Int NogoodPool::insert(PooledNogood&& pooled)
+{
+    // Store the nogood in a free slot.
+    Int idx;
+    if (!free_idx_.empty())
+    {
+        idx = free_idx_.back();
+        free_idx_.pop_back();
+        nogoods_[idx] = std::move(pooled);
+    }
+    else
+    {
+        idx = nogoods_.size();
+        nogoods_.push_back(std::move(pooled));
+    }
+
+    // Index the bounds.
+    const auto& nogood = nogoods_[idx].nogood;
+    for (size_t k = 0; k < nogood.vars.size(); ++k)
+    {
+        occurrences_[nogood.signs[k]][nogood.vars[k]].push_back(idx);
+    }
+    return idx;
+}
+
+SCIP_RETCODE NogoodPool::erase(SCIP* scip, const Int idx)
+{
+    // Remove the bounds from the index.
+    auto& pooled = nogoods_[idx];
+    for (size_t k = 0; k < pooled.nogood.vars.size(); ++k)
+    {
+        auto& occurrences = occurrences_[pooled.nogood.signs[k]];
+        const auto it = occurrences.find(pooled.nogood.vars[k]);
+        debug_assert(it != occurrences.end());
+        auto& list = it->second;
+        const auto list_it = std::find(list.begin(), list.end(), idx);
+        if (list_it != list.end())
+        {
+            *list_it = list.back();
+            list.pop_back();
+        }
+        if (list.empty())
+        {
+            occurrences.erase(it);
+        }
+    }
+
+    // Release the constraint. SCIP keeps the constraint if it is still in the problem.
+    if (pooled.cons)
+    {
+        SCIP_CALL(SCIPreleaseCons(scip, &pooled.cons));
+    }
+
+    // Free the slot.
+    pooled = PooledNogood{NogoodData{}, 0, nullptr, false};
+    free_idx_.push_back(idx);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE NogoodPool::drop_deleted(SCIP* scip)
+{
+    Int nb_dropped = 0;
+    for (Int idx = 0; idx < static_cast<Int>(nogoods_.size()); ++idx)
+        if (nogoods_[idx].cons && SCIPconsIsDeleted(nogoods_[idx].cons))
+        {
+            SCIP_CALL(erase(scip, idx));
+            ++nb_dropped;
+        }
+    debugln("   Dropping {} nogoods whose constraints were deleted", nb_dropped);
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE NogoodPool::age(SCIP* scip)
+{
+    // Drop the nogoods whose constraints were deleted.
+    nb_added_since_aging_ = 0;
+    SCIP_CALL(drop_deleted(scip));
+
+    // Make the nogoods dormant if their constraints are old.
+    Int nb_deactivated = 0;
+    for (auto& pooled : nogoods_)
+        if (pooled.is_active && SCIPconsGetAge(pooled.cons) >= NOGOOD_DORMANT_AGE)
+        {
+            SCIP_CALL(deactivate(scip, pooled));
+            ++nb_deactivated;
+        }
+    debugln("   Making {} nogoods dormant, leaving {} active and {} dormant",
+            nb_deactivated, nb_active(), nb_dormant());
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE NogoodPool::release(SCIP* scip)
+{
+    for (auto& pooled : nogoods_)
+        if (pooled.cons)
+        {
+            SCIP_CALL(SCIPreleaseCons(scip, &pooled.cons));
+        }
+    nogoods_.clear();
+    free_idx_.clear();
+    occurrences_[0].clear();
+    occurrences_[1].clear();
+    return SCIP_OKAY;
+}
+
+void NogoodPool::get_nogoods(Vector<NogoodData>& nogoods) const
+{
+    for (const auto& pooled : nogoods_)
+        if (!pooled.nogood.vars.empty())
+        {
+            nogoods.push_back(pooled.nogood);
+        }
+}
+
+Int NogoodPool::nb_active() const
+{
+    return std::count_if(nogoods_.begin(), nogoods_.end(),
+                         [](const PooledNogood& pooled) { return pooled.is_active; });
+}
+
+Int NogoodPool::nb_dormant() const
+{
+    return std::count_if(nogoods_.begin(), nogoods_.end(),
+                         [](const PooledNogood& pooled) { return pooled.cons && !pooled.is_active; });
+}
+
+SCIP_RETCODE NogoodPool::activate(SCIP* scip, PooledNogood& pooled)
+{
+    // Check.
+    debug_assert(!pooled.is_active);
+    const auto& nogood = pooled.nogood;
+
+    // Enable the constraint of a dormant nogood.
+    if (pooled.cons)
+    {
+        debug_assert(!SCIPconsIsDeleted(pooled.cons));
+        if (!SCIPconsIsEnabled(pooled.cons))
+        {
+            SCIP_CALL(SCIPenableCons(scip, pooled.cons));
+        }
+        pooled.is_active = true;
+        return SCIP_OKAY;
+    }
+
+    // Create constraint. The constraint is held by the pool until the nogood is removed from the pool.
+    if (nogood.all_binary)
+    {
+        // Get negated variables.
+        auto vars = nogood.vars;
+        for (size_t idx = 0; idx < vars.size(); ++idx)
+        {
+            debug_assert(SCIPvarIsBinary(vars[idx]));
+            if (nogood.signs[idx] == SCIP_BOUNDTYPE_UPPER)
+            {
+                debug_assert(nogood.bounds[idx] == 0);
+                SCIP_CALL(SCIPgetNegatedVar(scip, vars[idx], &vars[idx]));
+            }
+        }
+
+        // Create logic or constraint.
+        SCIP_CALL(SCIPcreateConsBasicLogicor(scip,
+                                             &pooled.cons,
+#ifndef NDEBUG
+                                             nogood.name.c_str(),
+#else
+                                             "",
+#endif
+                                             vars.size(),
+                                             vars.data()));
+    }
+    else
+    {
+        // Create bound disjunction constraint.
+        auto vars = nogood.vars;
+        auto signs = nogood.signs;
+        auto bounds = nogood.bounds;
+        SCIP_CALL(SCIPcreateConsBasicBounddisjunction(scip,
+                                                      &pooled.cons,
+#ifndef NDEBUG
+                                                      nogood.name.c_str(),
+#else
+                                                      "",
+#endif
+                                                      vars.size(),
+                                                      vars.data(),
+                                                      signs.data(),
+                                                      bounds.data()));
+    }
+    debug_assert(pooled.cons);
+
+    // Add constraint.
+    SCIP_CALL(SCIPaddCons(scip, pooled.cons));
+    pooled.is_active = true;
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE NogoodPool::deactivate(SCIP* scip, PooledNogood& pooled)
+{
+    // Check.
+    debug_assert(pooled.cons && pooled.is_active);
+
+    // Disable constraint. Deleting it during solving is not allowed at every node, while a disabled
+    // constraint is still checked and is enabled again if it is needed. The Geas constraint handler
+    // enforces the CP subproblem, so it finds the nogood again if a solution violates it.
+    if (SCIPconsIsActive(pooled.cons) && SCIPconsIsEnabled(pooled.cons))
+    {
+        SCIP_CALL(SCIPdisableCons(scip, pooled.cons));
+    }
+    pooled.is_active = false;
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+}
@@ -0,0 +1,101 @@
+#ifndef NUTMEG_NOGOODPOOL_H
+#define NUTMEG_NOGOODPOOL_H
+
+#include "Includes.h"
+#include <cstdint>
+
+namespace Nutmeg
+{
+
+// Disjunction of bounds on MIP variables that cuts off an assignment infeasible in the CP subproblem
+struct NogoodData
+{
+    Vector<SCIP_VAR*> vars;
+    Vector<SCIP_BOUNDTYPE> signs;
+    Vector<SCIP_Real> bounds;
+    bool all_binary{true};
+#ifndef NDEBUG
+    String name;
+#endif
+};
+
+// Nogood stored in the pool. Active nogoods are enabled constraints in the MIP. Dormant nogoods are
+// disabled constraints, which are still checked but not propagated, separated or enforced until a new
+// nogood shows they are needed again. Free slots have no bounds and no constraint.
+struct PooledNogood
+{
+    NogoodData nogood;
+    uint64_t signature;
+    SCIP_CONS* cons;
+    bool is_active;
+};
+
+// Outcome of adding a nogood to the pool
+enum class NogoodPoolResult
+{
+    Added,
+    Reactivated,
+    Subsumed
+};
+
+// Nogoods added to the transformed problem. A nogood subsumes another if each of its bounds implies a
+// bound of the other. New nogoods subsumed by a nogood in the pool are replaced by it, nogoods subsumed
+// by a new nogood are removed, and nogoods whose constraints stay unused for long become dormant.
+// Constraints are only disabled, never deleted, during solving. Nogoods whose constraints SCIP deleted,
+// such as when upgrading or removing them in presolving after a restart, are dropped from the pool. The
+// nogoods are indexed by the variable and sign of each bound, so a nogood is only compared with nogoods
+// sharing its bounds. Each nogood also has a signature with one bit per variable and sign, so a nogood
+// can only subsume another if its signature is a subset of the other's.
+class NogoodPool
+{
+    Vector<PooledNogood> nogoods_;
+    Vector<Int> free_idx_;
+    Array<HashTable<SCIP_VAR*, Vector<Int>>, 2> occurrences_;
+    Int nb_added_since_aging_;
+
+  public:
+    // Constructors
+    // ------------
+    NogoodPool() noexcept;
+    NogoodPool(const NogoodPool& pool) = default;
+    NogoodPool(NogoodPool&& pool) = default;
+    NogoodPool& operator=(const NogoodPool& pool) = default;
+    NogoodPool& operator=(NogoodPool&& pool) = default;
+    ~NogoodPool() = default;
+
+    // Add a nogood with at least two bounds as a constraint unless a nogood in the pool subsumes it. The
+    // constraint of the added nogood or of the subsuming nogood is returned, reactivated if dormant.
+    SCIP_RETCODE add(SCIP* scip, const NogoodData& nogood, NogoodPoolResult& pool_result, SCIP_CONS*& cons);
+
+    // Make the nogoods whose constraints are rarely used dormant
+    SCIP_RETCODE age(SCIP* scip);
+
+    // Release the constraints of the nogoods
+    SCIP_RETCODE release(SCIP* scip);
+
+    // Get the active and dormant nogoods
+    void get_nogoods(Vector<NogoodData>& nogoods) const;
+
+    // Get the number of nogoods
+    Int nb_active() const;
+    Int nb_dormant() const;
+
+  private:
+    // Insert or erase a nogood in the index. Erasing releases the constraint of the nogood.
+    Int insert(PooledNogood&& pooled);
+    SCIP_RETCODE erase(SCIP* scip, const Int idx);
+
+    // Find a nogood subsuming a nogood, or return -1
+    Int find_subsuming(const NogoodData& nogood, const uint64_t signature) const;
+
+    // Drop the nogoods whose constraints were deleted by SCIP
+    SCIP_RETCODE drop_deleted(SCIP* scip);
+
+    // Create or enable, or disable the constraint of a nogood
+    SCIP_RETCODE activate(SCIP* scip, PooledNogood& pooled);
+    SCIP_RETCODE deactivate(SCIP* scip, PooledNogood& pooled);
+};
+
+}
+
+#endif
@@ -0,0 +1,267 @@
+//#define PRINT_DEBUG
+
+#include "Presolver-Probing.h"
+#include <algorithm>
+
+#define PRESOL_NAME                         "cpprobing"
+#define PRESOL_DESC   "failed literals and implications in CP"
+#define PRESOL_PRIORITY                          -2000000 // priority of the presolver
+#define PRESOL_MAXROUNDS                                1 // maximal number of presolving rounds the presolver participates in
+#define PRESOL_TIMING      SCIP_PRESOLTIMING_EXHAUSTIVE   // timing of the presolver
+
+#define MAX_PROBING_DURATION                          5.0 // maximum run time of probing
+#define MAX_IMPLICATIONS_PER_LITERAL                  100 // maximum number of implications added for one probed literal
+
+namespace Nutmeg
+{
+
+// Literal on a Boolean variable
+struct Literal
+{
+    Int idx;
+    bool val;
+};
+
+// Assume a literal at the root of the CP solver and collect the Boolean variables it fixes. Returns false
+// if the literal fails.
+static
+bool probe_literal(
+    ProblemData& probdata,       // Problem data
+    const Literal& literal,      // Literal to probe
+    Vector<Literal>& implied     // Literals on other Boolean variables implied by the probed literal
+)
+{
+    // Get CP solver.
+    auto& cp = probdata.cp_;
+    auto& bool_vars_monitor = probdata.bool_vars_monitor_;
+    const auto& cp_var = probdata.cp_bool_vars_[literal.idx];
+
+    // Propagate the literal.
+    implied.clear();
+    cp.clear_assumptions();
+    bool_vars_monitor.reset();
+    if (!cp.assume(literal.val ? cp_var : ~cp_var) || !cp.is_consistent())
+    {
+        cp.clear_assumptions();
+        return false;
+    }
+
+    // Collect the fixed variables. Negated variables are skipped since the same implication is found on
+    // their positive variable.
+    for (auto idx : bool_vars_monitor.updated_lbs())
+        if (idx != literal.idx && probdata.is_pos_var(idx) && probdata.cp_bool_vars_[idx].lb(cp.data->state.p_vals))
+        {
+            implied.push_back({idx, true});
+        }
+    for (auto idx : bool_vars_monitor.updated_ubs())
+        if (idx != literal.idx && probdata.is_pos_var(idx) && !probdata.cp_bool_vars_[idx].ub(cp.data->state.p_vals))
+        {
+            implied.push_back({idx, false});
+        }
+    std::sort(implied.begin(), implied.end(), [](const Literal& a, const Literal& b) { return a.idx < b.idx; });
+
+    // Done.
+    cp.clear_assumptions();
+    return true;
+}
+
+// Fix a Boolean variable in the MIP and at the root of the CP solver. Returns false if infeasible.
+static
+bool fix_literal(
+    SCIP* scip,                  // SCIP
+    ProblemData& probdata,       // Problem data
+    const Literal& literal,      // Literal to fix
+    Int* nfixedvars              // Number of fixed variables
+)
+{
+    debugln("   Fixing {} = {}", probdata.bool_vars_name_[literal.idx], literal.val);
+
+    // Fix in the MIP.
+    SCIP_Bool infeasible = FALSE;
+    SCIP_Bool fixed = FALSE;
+    scip_assert(SCIPfixVar(scip, probdata.mip_bool_vars_[literal.idx], literal.val, &infeasible, &fixed));
+    if (infeasible)
+    {
+        return false;
+    }
+    *nfixedvars += fixed;
+
+    // Fix in CP.
+    const auto& cp_var = probdata.cp_bool_vars_[literal.idx];
+    return probdata.cp_.post(literal.val ? cp_var : ~cp_var);
+}
+
+// Add the literals implied by a literal as cliques. x = a implies y = b is the clique {x = a, y = 1 - b}.
+// Returns false if infeasible.
+static
+bool add_implications(
+    SCIP* scip,                      // SCIP
+    ProblemData& probdata,           // Problem data
+    const Literal& literal,          // Probed literal
+    const Vector<Literal>& implied,  // Literals implied by the probed literal
+    Int* nchgbds,                    // Number of changed bounds
+    SCIP_RESULT* result              // Pointer to store the result
+)
+{
+    const Int nb_implications = std::min<Int>(implied.size(), MAX_IMPLICATIONS_PER_LITERAL);
+    for (Int k = 0; k < nb_implications; ++k)
+    {
+        // Skip fixed variables.
+        auto implied_mip_var = probdata.mip_bool_vars_[implied[k].idx];
+        if (SCIPvarGetLbGlobal(implied_mip_var) > 0.5 || SCIPvarGetUbGlobal(implied_mip_var) < 0.5)
+        {
+            continue;
+        }
+
+        // Add clique.
+        SCIP_VAR* vars[2]{probdata.mip_bool_vars_[literal.idx], implied_mip_var};
+        SCIP_Bool vals[2]{literal.val, !implied[k].val};
+        SCIP_Bool infeasible = FALSE;
+        Int nbdchgs = 0;
+        scip_assert(SCIPaddClique(scip, vars, vals, 2, FALSE, &infeasible, &nbdchgs));
+        if (infeasible)
+        {
+            return false;
+        }
+        *nchgbds += nbdchgs;
+        if (nbdchgs > 0)
+        {
+            *result = SCIP_SUCCESS;
+        }
+    }
+    return true;
+}
+
+// Execution method of presolver
+static
+SCIP_DECL_PRESOLEXEC(presolExecProbing)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(presol);
+    debug_assert(strcmp(SCIPpresolGetName(presol), PRESOL_NAME) == 0);
+    debug_assert(nfixedvars);
+    debug_assert(result);
+
+    // Get problem data.
+    auto& probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(scip));
+    auto& cp = probdata.cp_;
+    if (probdata.nb_bool_vars() <= 2)
+    {
+        *result = SCIP_DIDNOTRUN;
+        return SCIP_OKAY;
+    }
+
+    // Get the time limit.
+    SCIP_Real time_limit;
+    scip_assert(SCIPgetRealParam(scip, "limits/time", &time_limit));
+    const auto end_time = std::min(SCIPgetSolvingTime(scip) + MAX_PROBING_DURATION, time_limit);
+
+    // Probe both values of every Boolean variable not already fixed. Negated variables are probed through
+    // their positive variable.
+    *result = SCIP_DIDNOTFIND;
+    Vector<Literal> implied_true;
+    Vector<Literal> implied_false;
+    for (Int idx = 2; idx < probdata.nb_bool_vars() && SCIPgetSolvingTime(scip) < end_time; ++idx)
+    {
+        // Skip negated variables.
+        if (!probdata.is_pos_var(idx))
+        {
+            continue;
+        }
+
+        // Skip fixed variables.
+        auto mip_var = probdata.mip_bool_vars_[idx];
+        debug_assert(mip_var);
+        const auto& cp_var = probdata.cp_bool_vars_[idx];
+        if (SCIPvarGetLbGlobal(mip_var) > 0.5 || SCIPvarGetUbGlobal(mip_var) < 0.5 ||
+            cp_var.lb(cp.data->state.p_vals) || !cp_var.ub(cp.data->state.p_vals))
+        {
+            continue;
+        }
+
+        // Probe.
+        const auto true_ok = probe_literal(probdata, {idx, true}, implied_true);
+        const auto false_ok = probe_literal(probdata, {idx, false}, implied_false);
+
+        // Fix failed literals.
+        if (!true_ok && !false_ok)
+        {
+            debugln("   Both values of {} fail", probdata.bool_vars_name_[idx]);
+            *result = SCIP_CUTOFF;
+            return SCIP_OKAY;
+        }
+        else if (!true_ok || !false_ok)
+        {
+            if (!fix_literal(scip, probdata, {idx, true_ok}, nfixedvars))
+            {
+                *result = SCIP_CUTOFF;
+                return SCIP_OKAY;
+            }
+            *result = SCIP_SUCCESS;
+            continue;
+        }
+
+        // Fix the literals implied by both values.
+        {
+            auto it_true = implied_true.begin();
+            auto it_false = implied_false.begin();
+            while (it_true != implied_true.end() && it_false != implied_false.end())
+                if (it_true->idx < it_false->idx)
+                {
+                    ++it_true;
+                }
+                else if (it_false->idx < it_true->idx)
+                {
+                    ++it_false;
+                }
+                else
+                {
+                    if (it_true->val == it_false->val)
+                    {
+                        if (!fix_literal(scip, probdata, *it_true, nfixedvars))
+                        {
+                            *result = SCIP_CUTOFF;
+                            return SCIP_OKAY;
+                        }
+                        *result = SCIP_SUCCESS;
+                    }
+                    ++it_true;
+                    ++it_false;
+                }
+        }
+
+        // Add the implications.
+        if (!add_implications(scip, probdata, {idx, true}, implied_true, nchgbds, result) ||
+            !add_implications(scip, probdata, {idx, false}, implied_false, nchgbds, result))
+        {
+            *result = SCIP_CUTOFF;
+            return SCIP_OKAY;
+        }
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Include presolver probing the Boolean variables in the CP model
+SCIP_RETCODE includePresolProbing(SCIP* scip)
+{
+    // Create presolver.
+    SCIP_PRESOL* presol = nullptr;
+    SCIP_CALL(SCIPincludePresolBasic(scip,
+                                     &presol,
+                                     PRESOL_NAME,
+                                     PRESOL_DESC,
+                                     PRESOL_PRIORITY,
+                                     PRESOL_MAXROUNDS,
+                                     PRESOL_TIMING,
+                                     presolExecProbing,
+                                     nullptr));
+    debug_assert(presol);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+}
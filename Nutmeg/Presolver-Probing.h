@@ -0,0 +1,19 @@
+#ifndef NUTMEG_PRESOLVER_PROBING_H
+#define NUTMEG_PRESOLVER_PROBING_H
+
+#include "Includes.h"
+#include "ProblemData.h"
+
+namespace Nutmeg
+{
+
+// Include presolver probing the Boolean variables in the CP model. Both values of each positive Boolean
+// variable are assumed at the root of the CP solver to find failed literals, literals implied by both
+// values and implications, which are added to the MIP as cliques. The variables are probed one after
+// another within a time budget because the model has a single CP solver, which cannot be copied into
+// replicas to probe disjoint sets of variables in parallel.
+SCIP_RETCODE includePresolProbing(SCIP* scip);
+
+}
+
+#endif
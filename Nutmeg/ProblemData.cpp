@@ -1,5 +1,10 @@
 #include "ProblemData.h"
 #include "Model.h"
+#include <algorithm>
+#include <numeric>
+
+#define ACTIVITY_DECAY                               0.95 // decay factor of variable activities after each nogood
+#define ACTIVITY_RESCALE_LIMIT                      1e100 // activities are rescaled when the increment exceeds this
 
 namespace Nutmeg
 {
@@ -27,11 +32,34 @@ ProblemData::ProblemData(Model& model, geas::solver& cp, Solution& sol) noexcept
 
     obj_var_idx_(-1),
     cp_dual_bound_(std::numeric_limits<Int>::min()),
+    next_obj_probe_node_(0),
 
     nb_linear_constraints_(0),
     nb_indicator_constraints_(0),
     nb_indicator_vars_setpart_constraints_(0),
     nb_indicator_vars_linking_constraints_(0),
+    lazy_cumulatives_(),
+    energetic_cumulatives_(),
+    alldifferents_(),
+    cp_scopes_(),
+    cp_components_(),
+
+    symmetry_groups_(),
+    symmetry_positions_(),
+
+    bool_vars_activity_(),
+    int_vars_activity_(),
+    activity_inc_(1.0),
+
+    nogoods_(),
+    nb_run_nogoods_(0),
+    nogood_pool_(),
+
+    nb_monitored_bool_vars_(0),
+    int_vars_monitored_(),
+
+    bool_vars_hint_(),
+    int_vars_hint_(),
 
     sol_(sol)
 {
@@ -152,4 +180,139 @@ const String& ProblemData::name(const IntVar var) const
     return int_vars_name_[var.idx];
 }
 
+void ProblemData::compute_cp_components()
+{
+    // Integer variables that appear in the MIP directly or through indicator variables are fixed in an
+    // integral solution and separate the components. Link the constraints through the other integer
+    // variables.
+    cp_components_.clear();
+    const auto is_cp_only = [&](const Int idx)
+    {
+        return !mip_int_vars_[idx] && mip_indicator_vars_idx_[idx].empty();
+    };
+    Vector<Int> parent(nb_int_vars());
+    std::iota(parent.begin(), parent.end(), 0);
+    const auto find = [&](Int idx)
+    {
+        while (parent[idx] != idx)
+        {
+            parent[idx] = parent[parent[idx]];
+            idx = parent[idx];
+        }
+        return idx;
+    };
+    for (const auto& scope : cp_scopes_)
+    {
+        Int root = -1;
+        for (const auto idx : scope.int_vars_idx)
+            if (idx > 0 && is_cp_only(idx))
+            {
+                if (root < 0)
+                    root = find(idx);
+                else
+                    parent[find(idx)] = root;
+            }
+    }
+
+    // Create a component for every group of linked constraints. Constraints only over variables in the
+    // MIP are placed together in one component.
+    HashTable<Int, Int> component_idx;
+    for (const auto& scope : cp_scopes_)
+    {
+        Int root = -1;
+        for (const auto idx : scope.int_vars_idx)
+            if (idx > 0 && is_cp_only(idx))
+            {
+                root = find(idx);
+                break;
+            }
+        const auto [it, is_new] = component_idx.emplace(root, cp_components_.size());
+        if (is_new)
+        {
+            cp_components_.emplace_back();
+        }
+        auto& component = cp_components_[it->second];
+
+        // Add variables.
+        for (const auto idx : scope.bool_vars_idx)
+            if (idx >= 2)
+            {
+                component.bool_vars_idx.push_back(idx);
+            }
+        for (const auto idx : scope.int_vars_idx)
+            if (idx > 0)
+            {
+                if (mip_int_vars_[idx])
+                {
+                    component.mip_int_vars_idx.push_back(idx);
+                }
+                else if (!mip_indicator_vars_idx_[idx].empty())
+                {
+                    for (const auto ind_var_idx : mip_indicator_vars_idx_[idx])
+                        if (ind_var_idx >= 2)
+                        {
+                            component.bool_vars_idx.push_back(ind_var_idx);
+                        }
+                }
+                else
+                {
+                    component.cp_int_vars_idx.push_back(idx);
+                }
+            }
+    }
+
+    // Remove duplicates.
+    const auto make_unique = [](Vector<Int>& vars_idx)
+    {
+        std::sort(vars_idx.begin(), vars_idx.end());
+        vars_idx.erase(std::unique(vars_idx.begin(), vars_idx.end()), vars_idx.end());
+    };
+    for (auto& component : cp_components_)
+    {
+        make_unique(component.bool_vars_idx);
+        make_unique(component.mip_int_vars_idx);
+        make_unique(component.cp_int_vars_idx);
+    }
+
+    // Check the CP subproblem as a whole if it does not decompose.
+    if (cp_components_.size() <= 1)
+    {
+        cp_components_.clear();
+    }
+}
+
+void ProblemData::bump_bool_var_activity(const Int idx)
+{
+    if (static_cast<Int>(bool_vars_activity_.size()) < nb_bool_vars())
+    {
+        bool_vars_activity_.resize(nb_bool_vars(), 0.0);
+    }
+    bool_vars_activity_[idx] += activity_inc_;
+}
+
+void ProblemData::bump_int_var_activity(const Int idx)
+{
+    if (static_cast<Int>(int_vars_activity_.size()) < nb_int_vars())
+    {
+        int_vars_activity_.resize(nb_int_vars(), 0.0);
+    }
+    int_vars_activity_[idx] += activity_inc_;
+}
+
+void ProblemData::decay_activities()
+{
+    // Increase the amount added to activities instead of decreasing all activities.
+    activity_inc_ /= ACTIVITY_DECAY;
+
+    // Rescale to avoid overflow.
+    if (activity_inc_ > ACTIVITY_RESCALE_LIMIT)
+    {
+        for (auto& activity : bool_vars_activity_)
+            activity /= ACTIVITY_RESCALE_LIMIT;
+        for (auto& activity : int_vars_activity_)
+            activity /= ACTIVITY_RESCALE_LIMIT;
+        activity_inc_ /= ACTIVITY_RESCALE_LIMIT;
+    }
+}
+
 }
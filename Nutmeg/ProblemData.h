@@ -4,6 +4,7 @@
 #include "Includes.h"
 #include "Variable.h"
 #include "Solution.h"
+#include "NogoodPool.h"
 #include "geas/solver/solver.h"
 #include "geas/constraints/builtins.h"
 #include "geas/vars/pred_var.h"
@@ -14,6 +15,61 @@ namespace Nutmeg
 
 class Model;
 
+// Cumulative constraint whose time-indexed relaxation is separated lazily
+struct CumulativeRelaxation
+{
+    Vector<IntVar> start;
+    Vector<Int> duration;
+    Vector<Int> resource;
+    Int capacity;
+    Int begin;
+    Int end;
+};
+
+// Optional cumulative constraint separated by energetic reasoning
+struct EnergeticRelaxation
+{
+    Vector<BoolVar> active;
+    Vector<IntVar> start;
+    Vector<Int> duration;
+    Vector<Int> resource;
+    Int capacity;
+};
+
+// Variables in the scope of a constraint of the CP subproblem
+struct CpScope
+{
+    Vector<Int> bool_vars_idx;
+    Vector<Int> int_vars_idx;
+};
+
+// Independent part of the CP subproblem. Components only share variables that appear in the MIP, which
+// are fixed by the assumptions on an integral solution, so every component can be checked on its own.
+struct CpComponent
+{
+    Vector<Int> bool_vars_idx;
+    Vector<Int> mip_int_vars_idx;
+    Vector<Int> cp_int_vars_idx;
+};
+
+// Interchangeable columns of variables. Swapping the variables of any two columns maps every solution to
+// a solution with the same objective value. Variables outside the columns are unchanged by the swap.
+struct SymmetryGroup
+{
+    Vector<Vector<Int>> bool_vars_idx;
+    Vector<Vector<Int>> int_vars_idx;
+};
+
+// Position of a MIP variable in a symmetry group
+struct SymmetryPosition
+{
+    Int group;
+    Int col;
+    Int row;
+    bool is_int;
+    bool is_neg;
+};
+
 struct ProblemData
 {
     // Model
@@ -43,12 +99,45 @@ struct ProblemData
     // Objective variable
     Int obj_var_idx_;
     Int cp_dual_bound_;
+    SCIP_Longint next_obj_probe_node_;
 
     // Constraints
     Int nb_linear_constraints_;
     Int nb_indicator_constraints_;
     Int nb_indicator_vars_setpart_constraints_;
     Int nb_indicator_vars_linking_constraints_;
+    Vector<CumulativeRelaxation> lazy_cumulatives_;
+    Vector<EnergeticRelaxation> energetic_cumulatives_;
+    Vector<Vector<IntVar>> alldifferents_;
+    Vector<CpScope> cp_scopes_;
+    Vector<CpComponent> cp_components_;
+
+    // Symmetries
+    Vector<SymmetryGroup> symmetry_groups_;
+    HashTable<SCIP_VAR*, SymmetryPosition> symmetry_positions_;
+
+    // Activity of variables in nogoods
+    Vector<Float> bool_vars_activity_;
+    Vector<Float> int_vars_activity_;
+    Float activity_inc_;
+
+    // Nogoods added to the transformed problem outside the pool, i.e., global fixings and proofs of
+    // optimality cuts, which stay valid after adding constraints to the model
+    Vector<NogoodData> nogoods_;
+
+    // Nogoods and global fixings found since the solve last restarted
+    Int nb_run_nogoods_;
+
+    // Nogoods with at least two bounds added to the transformed problem
+    NogoodPool nogood_pool_;
+
+    // Variables registered with the bounds monitors
+    Int nb_monitored_bool_vars_;
+    Vector<bool> int_vars_monitored_;
+
+    // Values suggested by the user for a start solution
+    Vector<Pair<Int, bool>> bool_vars_hint_;
+    Vector<Pair<Int, Int>> int_vars_hint_;
 
     // Solution
     Solution& sol_;
@@ -79,6 +168,14 @@ struct ProblemData
     Int ub(const IntVar var) const;
     const String& name(const BoolVar var) const;
     const String& name(const IntVar var) const;
+
+    // Split the CP subproblem into components
+    void compute_cp_components();
+
+    // Update the activity of variables in nogoods
+    void bump_bool_var_activity(const Int idx);
+    void bump_int_var_activity(const Int idx);
+    void decay_activities();
 };
 
 }
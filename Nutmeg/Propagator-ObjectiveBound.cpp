@@ -0,0 +1,183 @@
+//#define PRINT_DEBUG
+
+#include "Propagator-ObjectiveBound.h"
+
+#define PROP_NAME                          "objbound"
+#define PROP_DESC       "CP probing on the objective bound"
+#define PROP_PRIORITY                         -1000000 // priority of the propagator
+#define PROP_FREQ                                    1 // frequency for calling propagator
+#define PROP_DELAY                               FALSE // should propagator be delayed, if other propagators found
+                                                       // reductions?
+#define PROP_TIMING           SCIP_PROPTIMING_BEFORELP // timing of the propagator
+
+#define PROBE_NODE_INTERVAL                       1000 // number of nodes between two rounds of probing
+#define MAX_PROBE_DURATION                         1.0 // maximum run time of one round of probing
+#define MAX_PROBE_CONFLICTS                      10000 // maximum number of conflicts in one round of probing
+
+namespace Nutmeg
+{
+
+static inline
+Float get_time_remaining(
+    SCIP* scip    // SCIP
+)
+{
+    SCIP_Real time_limit;
+    scip_assert(SCIPgetRealParam(scip, "limits/time", &time_limit));
+    return time_limit - SCIPgetSolvingTime(scip);
+}
+
+// Find the smallest objective value feasible in the CP model by binary search on obj <= v. Returns the
+// lowest value not proven infeasible.
+static
+Int probe_objective_bound(
+    SCIP* scip,                 // SCIP
+    ProblemData& probdata,      // Problem data
+    Int lb,                     // Objective values below lb are known to be infeasible
+    Int ub                      // Upper end of the search
+)
+{
+    // Get CP solver.
+    auto& cp = probdata.cp_;
+    const auto& cp_obj_var = probdata.cp_int_vars_[probdata.obj_var_idx_];
+
+    // Search within the time limit. Each probe is stopped after the time remaining in the round, so
+    // an unfinished probe leaves the bound at its last proven value.
+    const auto start_time = SCIPgetSolvingTime(scip);
+    while (lb < ub)
+    {
+        // Get time remaining.
+        const auto time_remaining = std::min(MAX_PROBE_DURATION - (SCIPgetSolvingTime(scip) - start_time),
+                                             get_time_remaining(scip));
+        if (time_remaining <= 0)
+        {
+            break;
+        }
+
+        // Probe.
+        const auto mid = lb + (ub - lb) / 2;
+        cp.clear_assumptions();
+        auto cp_result = geas::solver::UNSAT;
+        if (cp.assume(cp_obj_var <= mid))
+        {
+            cp_result = cp.solve(limits{.time = time_remaining, .conflicts = MAX_PROBE_CONFLICTS});
+        }
+        debugln("   Probing obj <= {}: {}",
+                mid,
+                cp_result == geas::solver::SAT ? "SAT" : cp_result == geas::solver::UNSAT ? "UNSAT" : "UNKNOWN");
+
+        // Narrow the search.
+        if (cp_result == geas::solver::UNSAT)
+        {
+            lb = mid + 1;
+        }
+        else if (cp_result == geas::solver::SAT)
+        {
+            ub = mid;
+        }
+        else
+        {
+            break;
+        }
+    }
+    cp.clear_assumptions();
+
+    // Done.
+    return lb;
+}
+
+// Execution method of propagator
+static
+SCIP_DECL_PROPEXEC(propExecObjectiveBound)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(prop);
+    debug_assert(strcmp(SCIPpropGetName(prop), PROP_NAME) == 0);
+    debug_assert(result);
+
+    // Get problem data.
+    auto& probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(scip));
+    auto mip_obj_var = probdata.mip_int_vars_[probdata.obj_var_idx_];
+    debug_assert(mip_obj_var);
+    *result = SCIP_DIDNOTRUN;
+
+    // Probe at the root and then periodically.
+    if (SCIPgetNNodes(scip) >= probdata.next_obj_probe_node_)
+    {
+        probdata.next_obj_probe_node_ = SCIPgetNNodes(scip) + PROBE_NODE_INTERVAL;
+
+        // Search between the global bounds, up to the incumbent.
+        const auto lb = static_cast<Int>(SCIPceil(scip, SCIPvarGetLbGlobal(mip_obj_var)));
+        auto ub = static_cast<Int>(SCIPfloor(scip, SCIPvarGetUbGlobal(mip_obj_var)));
+        if (SCIPgetNSols(scip) > 0)
+        {
+            ub = std::min<Int>(ub, SCIPfloor(scip, SCIPgetUpperbound(scip)));
+        }
+        debugln("Probing objective bound in [{}, {}] at node {}", lb, ub, SCIPgetNNodes(scip));
+        const auto new_lb = probe_objective_bound(scip, probdata, std::max(lb, probdata.cp_dual_bound_), ub);
+        probdata.cp_dual_bound_ = std::max(probdata.cp_dual_bound_, new_lb);
+        *result = SCIP_DIDNOTFIND;
+    }
+
+    // Apply the bound proven by the CP solver.
+    if (SCIPisGT(scip, probdata.cp_dual_bound_, SCIPvarGetLbGlobal(mip_obj_var)))
+    {
+        debugln("Tightening objective bound to {}", probdata.cp_dual_bound_);
+        SCIP_Bool infeasible = FALSE;
+        SCIP_Bool tightened = FALSE;
+        SCIP_CALL(SCIPtightenVarLbGlobal(scip, mip_obj_var, probdata.cp_dual_bound_, FALSE, &infeasible, &tightened));
+        if (infeasible)
+        {
+            *result = SCIP_CUTOFF;
+        }
+        else if (tightened)
+        {
+            *result = SCIP_REDUCEDDOM;
+        }
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Solving process initialization method of propagator, called at the start of every run
+static
+SCIP_DECL_PROPINITSOL(propInitsolObjectiveBound)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(prop);
+    debug_assert(strcmp(SCIPpropGetName(prop), PROP_NAME) == 0);
+
+    // Probe at the root of every run since node counts start again after a restart.
+    auto& probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(scip));
+    probdata.next_obj_probe_node_ = 0;
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Include propagator for lower bounds on the objective variable proven by the CP solver
+SCIP_RETCODE includePropObjectiveBound(SCIP* scip)
+{
+    // Create propagator.
+    SCIP_PROP* prop = nullptr;
+    SCIP_CALL(SCIPincludePropBasic(scip,
+                                   &prop,
+                                   PROP_NAME,
+                                   PROP_DESC,
+                                   PROP_PRIORITY,
+                                   PROP_FREQ,
+                                   PROP_DELAY,
+                                   PROP_TIMING,
+                                   propExecObjectiveBound,
+                                   nullptr));
+    debug_assert(prop);
+    SCIP_CALL(SCIPsetPropInitsol(scip, prop, propInitsolObjectiveBound));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+}
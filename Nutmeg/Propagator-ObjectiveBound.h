@@ -0,0 +1,15 @@
+#ifndef NUTMEG_PROPAGATOR_OBJECTIVEBOUND_H
+#define NUTMEG_PROPAGATOR_OBJECTIVEBOUND_H
+
+#include "Includes.h"
+#include "ProblemData.h"
+
+namespace Nutmeg
+{
+
+// Include propagator for lower bounds on the objective variable proven by the CP solver
+SCIP_RETCODE includePropObjectiveBound(SCIP* scip);
+
+}
+
+#endif
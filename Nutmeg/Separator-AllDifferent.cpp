@@ -0,0 +1,310 @@
+//#define PRINT_DEBUG
+
+#include "Separator-AllDifferent.h"
+#include <algorithm>
+
+#define SEPA_NAME                       "alldifferent"
+#define SEPA_DESC       "Hall-interval cuts of alldifferent"
+#define SEPA_PRIORITY                              1000 // priority of the separator
+#define SEPA_FREQ                                     1 // frequency for calling separator
+#define SEPA_MAXBOUNDDIST                           1.0 // maximal relative distance from current node's dual bound to
+                                                        // primal bound compared to best node's dual bound for applying
+                                                        // separation
+#define SEPA_USESSUBSCIP                          FALSE // does the separator use a secondary SCIP instance?
+#define SEPA_DELAY                                FALSE // should separation method be delayed, if other separators found
+                                                        // cuts?
+
+#define MAX_CUTS_PER_ROUND                           20 // maximum number of cuts added per alldifferent constraint
+
+namespace Nutmeg
+{
+
+struct HallIntervalCut
+{
+    Float violation;
+    Vector<Int> vars;
+    Float lhs;
+    Float rhs;
+};
+
+// Find the most violated cut over the variables whose domains lie above a value. The k variables with the
+// smallest solution values must take k distinct values from a upwards.
+// sum(i in S) x[i] >= |S| * a + |S| * (|S| - 1) / 2
+static
+void find_lower_cut(
+    SCIP* scip,                       // SCIP
+    const Vector<Int>& lb,            // Lower bounds
+    const Vector<Float>& val,         // Solution values
+    const Int a,                      // Lower end of the interval
+    Vector<Int>& order,               // Buffer
+    Vector<HallIntervalCut>& cuts     // Output cuts
+)
+{
+    // Sort the variables above a by increasing solution value.
+    order.clear();
+    for (Int i = 0; i < static_cast<Int>(lb.size()); ++i)
+        if (lb[i] >= a)
+        {
+            order.push_back(i);
+        }
+    std::sort(order.begin(), order.end(), [&](const Int i, const Int j) { return val[i] < val[j]; });
+
+    // Find the most violated prefix.
+    Float sum = 0;
+    Float best_violation = 0;
+    Int best_size = 0;
+    for (Int k = 1; k <= static_cast<Int>(order.size()); ++k)
+    {
+        sum += val[order[k - 1]];
+        const Float bound = static_cast<Float>(k) * a + static_cast<Float>(k) * (k - 1) / 2;
+        if (SCIPisFeasLT(scip, sum, bound) && bound - sum > best_violation)
+        {
+            best_violation = bound - sum;
+            best_size = k;
+        }
+    }
+    if (best_size > 1)
+    {
+        const Float bound = static_cast<Float>(best_size) * a + static_cast<Float>(best_size) * (best_size - 1) / 2;
+        cuts.push_back({best_violation / best_size,
+                        Vector<Int>(order.begin(), order.begin() + best_size),
+                        bound,
+                        SCIPinfinity(scip)});
+    }
+}
+
+// Find the most violated cut over the variables whose domains lie below a value.
+// sum(i in S) x[i] <= |S| * b - |S| * (|S| - 1) / 2
+static
+void find_upper_cut(
+    SCIP* scip,                       // SCIP
+    const Vector<Int>& ub,            // Upper bounds
+    const Vector<Float>& val,         // Solution values
+    const Int b,                      // Upper end of the interval
+    Vector<Int>& order,               // Buffer
+    Vector<HallIntervalCut>& cuts     // Output cuts
+)
+{
+    // Sort the variables below b by decreasing solution value.
+    order.clear();
+    for (Int i = 0; i < static_cast<Int>(ub.size()); ++i)
+        if (ub[i] <= b)
+        {
+            order.push_back(i);
+        }
+    std::sort(order.begin(), order.end(), [&](const Int i, const Int j) { return val[i] > val[j]; });
+
+    // Find the most violated prefix.
+    Float sum = 0;
+    Float best_violation = 0;
+    Int best_size = 0;
+    for (Int k = 1; k <= static_cast<Int>(order.size()); ++k)
+    {
+        sum += val[order[k - 1]];
+        const Float bound = static_cast<Float>(k) * b - static_cast<Float>(k) * (k - 1) / 2;
+        if (SCIPisFeasGT(scip, sum, bound) && sum - bound > best_violation)
+        {
+            best_violation = sum - bound;
+            best_size = k;
+        }
+    }
+    if (best_size > 1)
+    {
+        const Float bound = static_cast<Float>(best_size) * b - static_cast<Float>(best_size) * (best_size - 1) / 2;
+        cuts.push_back({best_violation / best_size,
+                        Vector<Int>(order.begin(), order.begin() + best_size),
+                        -SCIPinfinity(scip),
+                        bound});
+    }
+}
+
+// Find the Hall-interval cuts of an alldifferent constraint violated by a solution
+static
+SCIP_RETCODE separate_alldifferent(
+    SCIP* scip,                       // SCIP
+    SCIP_SEPA* sepa,                  // Separator
+    SCIP_SOL* sol,                    // Solution, or null for the LP solution
+    const ProblemData& probdata,      // Problem data
+    const Vector<IntVar>& vars,       // Variables of the alldifferent constraint
+    SCIP_RESULT* result               // Pointer to store the result
+)
+{
+    // Get the bounds and the solution values.
+    const Int N = vars.size();
+    Vector<Int> lb(N);
+    Vector<Int> ub(N);
+    Vector<Float> val(N);
+    for (Int i = 0; i < N; ++i)
+    {
+        lb[i] = probdata.lb(vars[i]);
+        ub[i] = probdata.ub(vars[i]);
+        val[i] = SCIPgetSolVal(scip, sol, probdata.mip_var(vars[i]));
+    }
+
+    // Find the most violated cut for every interval end.
+    Vector<HallIntervalCut> cuts;
+    Vector<Int> order;
+    {
+        auto values = lb;
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        for (const auto a : values)
+        {
+            find_lower_cut(scip, lb, val, a, order, cuts);
+        }
+    }
+    {
+        auto values = ub;
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        for (const auto b : values)
+        {
+            find_upper_cut(scip, ub, val, b, order, cuts);
+        }
+    }
+    if (cuts.empty())
+    {
+        return SCIP_OKAY;
+    }
+
+    // Keep the most violated cuts.
+    if (cuts.size() > MAX_CUTS_PER_ROUND)
+    {
+        std::nth_element(cuts.begin(),
+                         cuts.begin() + MAX_CUTS_PER_ROUND,
+                         cuts.end(),
+                         [](const auto& a, const auto& b) { return a.violation > b.violation; });
+        cuts.resize(MAX_CUTS_PER_ROUND);
+    }
+
+    // Add the cuts.
+    for (const auto& cut : cuts)
+    {
+        debugln("Adding Hall-interval cut on {} variables with violation {:.4f}", cut.vars.size(), cut.violation);
+
+        // Create row.
+        SCIP_ROW* row = nullptr;
+        SCIP_CALL(SCIPcreateEmptyRowSepa(scip, &row, sepa, "", cut.lhs, cut.rhs, FALSE, FALSE, TRUE));
+        debug_assert(row);
+
+        // Add variables to row.
+        SCIP_CALL(SCIPcacheRowExtensions(scip, row));
+        for (const auto i : cut.vars)
+        {
+            SCIP_CALL(SCIPaddVarToRow(scip, row, probdata.mip_var(vars[i]), 1.0));
+        }
+        SCIP_CALL(SCIPflushRowExtensions(scip, row));
+
+        // Add row to the LP and to the cut pool.
+        SCIP_Bool infeasible = FALSE;
+        SCIP_CALL(SCIPaddRow(scip, row, FALSE, &infeasible));
+        if (!infeasible)
+        {
+            SCIP_CALL(SCIPaddPoolCut(scip, row));
+        }
+        SCIP_CALL(SCIPreleaseRow(scip, &row));
+
+        // Update result.
+        if (infeasible)
+        {
+            *result = SCIP_CUTOFF;
+            return SCIP_OKAY;
+        }
+        *result = SCIP_SEPARATED;
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Separate all alldifferent constraints
+static
+SCIP_RETCODE separate(
+    SCIP* scip,             // SCIP
+    SCIP_SEPA* sepa,        // Separator
+    SCIP_SOL* sol,          // Solution, or null for the LP solution
+    SCIP_RESULT* result     // Pointer to store the result
+)
+{
+    // Get problem data.
+    const auto& probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(scip));
+    if (probdata.alldifferents_.empty())
+    {
+        *result = SCIP_DIDNOTRUN;
+        return SCIP_OKAY;
+    }
+
+    // Separate.
+    *result = SCIP_DIDNOTFIND;
+    for (const auto& vars : probdata.alldifferents_)
+    {
+        SCIP_CALL(separate_alldifferent(scip, sepa, sol, probdata, vars, result));
+        if (*result == SCIP_CUTOFF)
+        {
+            break;
+        }
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// LP solution separation method of separator
+static
+SCIP_DECL_SEPAEXECLP(sepaExeclpAllDifferent)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(sepa);
+    debug_assert(strcmp(SCIPsepaGetName(sepa), SEPA_NAME) == 0);
+    debug_assert(result);
+
+    // Separate.
+    SCIP_CALL(separate(scip, sepa, nullptr, result));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Arbitrary primal solution separation method of separator
+static
+SCIP_DECL_SEPAEXECSOL(sepaExecsolAllDifferent)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(sepa);
+    debug_assert(strcmp(SCIPsepaGetName(sepa), SEPA_NAME) == 0);
+    debug_assert(sol);
+    debug_assert(result);
+
+    // Separate.
+    SCIP_CALL(separate(scip, sepa, sol, result));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Include separator for the Hall-interval cuts of alldifferent constraints
+SCIP_RETCODE includeSepaAllDifferent(SCIP* scip)
+{
+    // Create separator.
+    SCIP_SEPA* sepa = nullptr;
+    SCIP_CALL(SCIPincludeSepaBasic(scip,
+                                   &sepa,
+                                   SEPA_NAME,
+                                   SEPA_DESC,
+                                   SEPA_PRIORITY,
+                                   SEPA_FREQ,
+                                   SEPA_MAXBOUNDDIST,
+                                   SEPA_USESSUBSCIP,
+                                   SEPA_DELAY,
+                                   sepaExeclpAllDifferent,
+                                   sepaExecsolAllDifferent,
+                                   nullptr));
+    debug_assert(sepa);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+}
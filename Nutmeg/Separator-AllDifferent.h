@@ -0,0 +1,15 @@
+#ifndef NUTMEG_SEPARATOR_ALLDIFFERENT_H
+#define NUTMEG_SEPARATOR_ALLDIFFERENT_H
+
+#include "Includes.h"
+#include "ProblemData.h"
+
+namespace Nutmeg
+{
+
+// Include separator for the Hall-interval cuts of alldifferent constraints
+SCIP_RETCODE includeSepaAllDifferent(SCIP* scip);
+
+}
+
+#endif
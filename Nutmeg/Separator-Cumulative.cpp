@@ -0,0 +1,231 @@
+//#define PRINT_DEBUG
+
+#include "Separator-Cumulative.h"
+#include <algorithm>
+
+#define SEPA_NAME                         "cumulative"
+#define SEPA_DESC     "time-indexed cumulative relaxation"
+#define SEPA_PRIORITY                              1000 // priority of the separator
+#define SEPA_FREQ                                     1 // frequency for calling separator
+#define SEPA_MAXBOUNDDIST                           1.0 // maximal relative distance from current node's dual bound to
+                                                        // primal bound compared to best node's dual bound for applying
+                                                        // separation
+#define SEPA_USESSUBSCIP                          FALSE // does the separator use a secondary SCIP instance?
+#define SEPA_DELAY                                FALSE // should separation method be delayed, if other separators found
+                                                        // cuts?
+
+#define MAX_CUTS_PER_ROUND                           50 // maximum number of time slices added per cumulative constraint
+
+namespace Nutmeg
+{
+
+// Find the time slices of a cumulative constraint whose resource usage exceeds the capacity in a solution
+static
+SCIP_RETCODE separate_cumulative(
+    SCIP* scip,                                 // SCIP
+    SCIP_SEPA* sepa,                            // Separator
+    SCIP_SOL* sol,                              // Solution, or null for the LP solution
+    const ProblemData& probdata,                // Problem data
+    const CumulativeRelaxation& cumulative,     // Cumulative constraint
+    SCIP_RESULT* result                         // Pointer to store the result
+)
+{
+    // Sum the resource usage at every time point. Each start time value adds its usage to the time
+    // points it covers, using a difference array to avoid iterating over the duration.
+    const auto& start = cumulative.start;
+    const auto& duration = cumulative.duration;
+    const auto& resource = cumulative.resource;
+    const auto begin = cumulative.begin;
+    const auto end = cumulative.end;
+    const Int N = start.size();
+    Vector<Float> load(end - begin + 2, 0.0);
+    for (Int j = 0; j < N; ++j)
+        if (resource[j] > 0 && duration[j] > 0)
+        {
+            for (Int u = probdata.lb(start[j]); u <= probdata.ub(start[j]); ++u)
+            {
+                auto var = probdata.mip_indicator_var(start[j], u);
+                debug_assert(var);
+                const auto val = SCIPgetSolVal(scip, sol, var);
+                if (SCIPisPositive(scip, val))
+                {
+                    load[u - begin] += resource[j] * val;
+                    load[std::min(u + duration[j], end + 1) - begin] -= resource[j] * val;
+                }
+            }
+        }
+    for (Int t = 1; t < static_cast<Int>(load.size()); ++t)
+    {
+        load[t] += load[t - 1];
+    }
+
+    // Find the violated time slices.
+    Vector<Pair<Float, Int>> violated;
+    for (Int t = begin; t <= end; ++t)
+        if (SCIPisFeasGT(scip, load[t - begin], cumulative.capacity))
+        {
+            violated.emplace_back(load[t - begin] - cumulative.capacity, t);
+        }
+    if (violated.empty())
+    {
+        return SCIP_OKAY;
+    }
+
+    // Keep the most violated time slices.
+    if (violated.size() > MAX_CUTS_PER_ROUND)
+    {
+        std::nth_element(violated.begin(),
+                         violated.begin() + MAX_CUTS_PER_ROUND,
+                         violated.end(),
+                         [](const auto& a, const auto& b) { return a.first > b.first; });
+        violated.resize(MAX_CUTS_PER_ROUND);
+    }
+
+    // Add the time slices as cuts.
+    // sum(j in tasks, u in [t - duration[j] + 1, t]) (resource[j] * [start[j] == u]) <= capacity
+    for (const auto& [violation, t] : violated)
+    {
+        debugln("Adding cumulative time slice {} with violation {:.4f}", t, violation);
+
+        // Create row. The row is removable so that SCIP ages it out of the LP once it stays slack.
+        SCIP_ROW* row = nullptr;
+        SCIP_CALL(SCIPcreateEmptyRowSepa(scip,
+                                         &row,
+                                         sepa,
+                                         "",
+                                         -SCIPinfinity(scip),
+                                         cumulative.capacity,
+                                         FALSE,
+                                         FALSE,
+                                         TRUE));
+        debug_assert(row);
+
+        // Add variables to row.
+        SCIP_CALL(SCIPcacheRowExtensions(scip, row));
+        for (Int j = 0; j < N; ++j)
+            if (resource[j] > 0 && duration[j] > 0)
+            {
+                for (Int u = std::max(t - duration[j] + 1, probdata.lb(start[j]));
+                     u <= std::min(t, probdata.ub(start[j]));
+                     ++u)
+                {
+                    auto var = probdata.mip_indicator_var(start[j], u);
+                    debug_assert(var);
+                    SCIP_CALL(SCIPaddVarToRow(scip, row, var, resource[j]));
+                }
+            }
+        SCIP_CALL(SCIPflushRowExtensions(scip, row));
+
+        // Add row to the LP and to the cut pool, from which it can return after being aged out.
+        SCIP_Bool infeasible = FALSE;
+        SCIP_CALL(SCIPaddRow(scip, row, FALSE, &infeasible));
+        if (!infeasible)
+        {
+            SCIP_CALL(SCIPaddPoolCut(scip, row));
+        }
+        SCIP_CALL(SCIPreleaseRow(scip, &row));
+
+        // Update result.
+        if (infeasible)
+        {
+            *result = SCIP_CUTOFF;
+            return SCIP_OKAY;
+        }
+        *result = SCIP_SEPARATED;
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Separate all cumulative constraints
+static
+SCIP_RETCODE separate(
+    SCIP* scip,             // SCIP
+    SCIP_SEPA* sepa,        // Separator
+    SCIP_SOL* sol,          // Solution, or null for the LP solution
+    SCIP_RESULT* result     // Pointer to store the result
+)
+{
+    // Get problem data.
+    const auto& probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(scip));
+    if (probdata.lazy_cumulatives_.empty())
+    {
+        *result = SCIP_DIDNOTRUN;
+        return SCIP_OKAY;
+    }
+
+    // Separate.
+    *result = SCIP_DIDNOTFIND;
+    for (const auto& cumulative : probdata.lazy_cumulatives_)
+    {
+        SCIP_CALL(separate_cumulative(scip, sepa, sol, probdata, cumulative, result));
+        if (*result == SCIP_CUTOFF)
+        {
+            break;
+        }
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// LP solution separation method of separator
+static
+SCIP_DECL_SEPAEXECLP(sepaExeclpCumulative)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(sepa);
+    debug_assert(strcmp(SCIPsepaGetName(sepa), SEPA_NAME) == 0);
+    debug_assert(result);
+
+    // Separate.
+    SCIP_CALL(separate(scip, sepa, nullptr, result));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Arbitrary primal solution separation method of separator
+static
+SCIP_DECL_SEPAEXECSOL(sepaExecsolCumulative)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(sepa);
+    debug_assert(strcmp(SCIPsepaGetName(sepa), SEPA_NAME) == 0);
+    debug_assert(sol);
+    debug_assert(result);
+
+    // Separate.
+    SCIP_CALL(separate(scip, sepa, sol, result));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Include separator for the time-indexed relaxation of cumulative constraints
+SCIP_RETCODE includeSepaCumulative(SCIP* scip)
+{
+    // Create separator.
+    SCIP_SEPA* sepa = nullptr;
+    SCIP_CALL(SCIPincludeSepaBasic(scip,
+                                   &sepa,
+                                   SEPA_NAME,
+                                   SEPA_DESC,
+                                   SEPA_PRIORITY,
+                                   SEPA_FREQ,
+                                   SEPA_MAXBOUNDDIST,
+                                   SEPA_USESSUBSCIP,
+                                   SEPA_DELAY,
+                                   sepaExeclpCumulative,
+                                   sepaExecsolCumulative,
+                                   nullptr));
+    debug_assert(sepa);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+}
@@ -0,0 +1,15 @@
+#ifndef NUTMEG_SEPARATOR_CUMULATIVE_H
+#define NUTMEG_SEPARATOR_CUMULATIVE_H
+
+#include "Includes.h"
+#include "ProblemData.h"
+
+namespace Nutmeg
+{
+
+// Include separator for the time-indexed relaxation of cumulative constraints
+SCIP_RETCODE includeSepaCumulative(SCIP* scip);
+
+}
+
+#endif
@@ -0,0 +1,255 @@
+//#define PRINT_DEBUG
+
+#include "Separator-Energetic.h"
+#include <algorithm>
+#include <tuple>
+
+#define SEPA_NAME                          "energetic"
+#define SEPA_DESC   "energetic reasoning over time windows"
+#define SEPA_PRIORITY                              1000 // priority of the separator
+#define SEPA_FREQ                                     1 // frequency for calling separator
+#define SEPA_MAXBOUNDDIST                           1.0 // maximal relative distance from current node's dual bound to
+                                                        // primal bound compared to best node's dual bound for applying
+                                                        // separation
+#define SEPA_USESSUBSCIP                          FALSE // does the separator use a secondary SCIP instance?
+#define SEPA_DELAY                                FALSE // should separation method be delayed, if other separators found
+                                                        // cuts?
+
+#define MAX_CUTS_PER_ROUND                           20 // maximum number of windows added per cumulative constraint
+
+namespace Nutmeg
+{
+
+// Energy that a task must spend inside the window [t1, t2) if it runs, given its release time and deadline
+static inline Int minimum_overlap(const Int release, const Int deadline, const Int duration, const Int t1, const Int t2)
+{
+    const auto left_shifted = std::min(t2, release + duration) - std::max(t1, release);
+    const auto right_shifted = std::min(t2, deadline) - std::max(t1, deadline - duration);
+    return std::max<Int>(0, std::min(left_shifted, right_shifted));
+}
+
+// Find the time windows of an optional cumulative constraint whose minimum energy exceeds the capacity in a
+// solution
+static
+SCIP_RETCODE separate_cumulative(
+    SCIP* scip,                                 // SCIP
+    SCIP_SEPA* sepa,                            // Separator
+    SCIP_SOL* sol,                              // Solution, or null for the LP solution
+    const ProblemData& probdata,                // Problem data
+    const EnergeticRelaxation& cumulative,      // Cumulative constraint
+    SCIP_RESULT* result                         // Pointer to store the result
+)
+{
+    // Get the time window and the solution value of every task.
+    const auto& active = cumulative.active;
+    const auto& start = cumulative.start;
+    const auto& duration = cumulative.duration;
+    const auto& resource = cumulative.resource;
+    const Int N = start.size();
+    Vector<Int> release(N);
+    Vector<Int> deadline(N);
+    Vector<Float> val(N);
+    Vector<Int> tasks;
+    Vector<Int> t1s;
+    Vector<Int> t2s;
+    for (Int j = 0; j < N; ++j)
+        if (resource[j] > 0 && duration[j] > 0)
+        {
+            release[j] = probdata.lb(start[j]);
+            deadline[j] = probdata.ub(start[j]) + duration[j];
+            val[j] = SCIPgetSolVal(scip, sol, probdata.mip_var(active[j]));
+            if (SCIPisPositive(scip, val[j]))
+            {
+                tasks.push_back(j);
+                t1s.push_back(release[j]);
+                t2s.push_back(deadline[j]);
+            }
+        }
+    if (tasks.size() <= 1)
+    {
+        return SCIP_OKAY;
+    }
+
+    // Windows only need to start at a release time and end at a deadline.
+    std::sort(t1s.begin(), t1s.end());
+    t1s.erase(std::unique(t1s.begin(), t1s.end()), t1s.end());
+    std::sort(t2s.begin(), t2s.end());
+    t2s.erase(std::unique(t2s.begin(), t2s.end()), t2s.end());
+
+    // Find the violated windows.
+    // sum(j in tasks) (resource[j] * minimum_overlap[j] * active[j]) <= capacity * (t2 - t1)
+    Vector<std::tuple<Float, Int, Int>> violated;
+    for (const auto t1 : t1s)
+        for (auto it = std::upper_bound(t2s.begin(), t2s.end(), t1); it != t2s.end(); ++it)
+        {
+            const auto t2 = *it;
+            Float lhs = 0;
+            for (const auto j : tasks)
+            {
+                lhs += resource[j] * minimum_overlap(release[j], deadline[j], duration[j], t1, t2) * val[j];
+            }
+            const auto rhs = cumulative.capacity * (t2 - t1);
+            if (SCIPisFeasGT(scip, lhs, rhs))
+            {
+                violated.emplace_back((lhs - rhs) / std::max<Int>(rhs, 1), t1, t2);
+            }
+        }
+    if (violated.empty())
+    {
+        return SCIP_OKAY;
+    }
+
+    // Keep the most violated windows.
+    if (violated.size() > MAX_CUTS_PER_ROUND)
+    {
+        std::nth_element(violated.begin(),
+                         violated.begin() + MAX_CUTS_PER_ROUND,
+                         violated.end(),
+                         [](const auto& a, const auto& b) { return std::get<0>(a) > std::get<0>(b); });
+        violated.resize(MAX_CUTS_PER_ROUND);
+    }
+
+    // Add the windows as cuts. Every task is included, not only those active in the solution.
+    for (const auto& [violation, t1, t2] : violated)
+    {
+        debugln("Adding energetic cut on window [{}, {}) with relative violation {:.4f}", t1, t2, violation);
+
+        // Create row.
+        SCIP_ROW* row = nullptr;
+        SCIP_CALL(SCIPcreateEmptyRowSepa(scip,
+                                         &row,
+                                         sepa,
+                                         "",
+                                         -SCIPinfinity(scip),
+                                         cumulative.capacity * (t2 - t1),
+                                         FALSE,
+                                         FALSE,
+                                         TRUE));
+        debug_assert(row);
+
+        // Add variables to row.
+        SCIP_CALL(SCIPcacheRowExtensions(scip, row));
+        for (Int j = 0; j < N; ++j)
+            if (resource[j] > 0 && duration[j] > 0)
+            {
+                const auto overlap = minimum_overlap(release[j], deadline[j], duration[j], t1, t2);
+                if (overlap > 0)
+                {
+                    SCIP_CALL(SCIPaddVarToRow(scip, row, probdata.mip_var(active[j]), resource[j] * overlap));
+                }
+            }
+        SCIP_CALL(SCIPflushRowExtensions(scip, row));
+
+        // Add row to the LP and to the cut pool.
+        SCIP_Bool infeasible = FALSE;
+        SCIP_CALL(SCIPaddRow(scip, row, FALSE, &infeasible));
+        if (!infeasible)
+        {
+            SCIP_CALL(SCIPaddPoolCut(scip, row));
+        }
+        SCIP_CALL(SCIPreleaseRow(scip, &row));
+
+        // Update result.
+        if (infeasible)
+        {
+            *result = SCIP_CUTOFF;
+            return SCIP_OKAY;
+        }
+        *result = SCIP_SEPARATED;
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Separate all optional cumulative constraints
+static
+SCIP_RETCODE separate(
+    SCIP* scip,             // SCIP
+    SCIP_SEPA* sepa,        // Separator
+    SCIP_SOL* sol,          // Solution, or null for the LP solution
+    SCIP_RESULT* result     // Pointer to store the result
+)
+{
+    // Get problem data.
+    const auto& probdata = *reinterpret_cast<ProblemData*>(SCIPgetProbData(scip));
+    if (probdata.energetic_cumulatives_.empty())
+    {
+        *result = SCIP_DIDNOTRUN;
+        return SCIP_OKAY;
+    }
+
+    // Separate.
+    *result = SCIP_DIDNOTFIND;
+    for (const auto& cumulative : probdata.energetic_cumulatives_)
+    {
+        SCIP_CALL(separate_cumulative(scip, sepa, sol, probdata, cumulative, result));
+        if (*result == SCIP_CUTOFF)
+        {
+            break;
+        }
+    }
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// LP solution separation method of separator
+static
+SCIP_DECL_SEPAEXECLP(sepaExeclpEnergetic)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(sepa);
+    debug_assert(strcmp(SCIPsepaGetName(sepa), SEPA_NAME) == 0);
+    debug_assert(result);
+
+    // Separate.
+    SCIP_CALL(separate(scip, sepa, nullptr, result));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Arbitrary primal solution separation method of separator
+static
+SCIP_DECL_SEPAEXECSOL(sepaExecsolEnergetic)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(sepa);
+    debug_assert(strcmp(SCIPsepaGetName(sepa), SEPA_NAME) == 0);
+    debug_assert(sol);
+    debug_assert(result);
+
+    // Separate.
+    SCIP_CALL(separate(scip, sepa, sol, result));
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+// Include separator for the energetic reasoning cuts of optional cumulative constraints
+SCIP_RETCODE includeSepaEnergetic(SCIP* scip)
+{
+    // Create separator.
+    SCIP_SEPA* sepa = nullptr;
+    SCIP_CALL(SCIPincludeSepaBasic(scip,
+                                   &sepa,
+                                   SEPA_NAME,
+                                   SEPA_DESC,
+                                   SEPA_PRIORITY,
+                                   SEPA_FREQ,
+                                   SEPA_MAXBOUNDDIST,
+                                   SEPA_USESSUBSCIP,
+                                   SEPA_DELAY,
+                                   sepaExeclpEnergetic,
+                                   sepaExecsolEnergetic,
+                                   nullptr));
+    debug_assert(sepa);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+}
@@ -0,0 +1,15 @@
+#ifndef NUTMEG_SEPARATOR_ENERGETIC_H
+#define NUTMEG_SEPARATOR_ENERGETIC_H
+
+#include "Includes.h"
+#include "ProblemData.h"
+
+namespace Nutmeg
+{
+
+// Include separator for the energetic reasoning cuts of optional cumulative constraints
+SCIP_RETCODE includeSepaEnergetic(SCIP* scip);
+
+}
+
+#endif
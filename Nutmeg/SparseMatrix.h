@@ -0,0 +1,108 @@
+#ifndef NUTMEG_SPARSEMATRIX_H
+#define NUTMEG_SPARSEMATRIX_H
+
+#include "Matrix.h"
+#include <vector>
+
+// Row-major matrix storing only the entries of a fixed sparsity pattern (compressed sparse row format).
+// Entries of row i are indexed by k in [row_begin(i), row_end(i)) in increasing column order.
+template<typename T>
+class SparseMatrix
+{
+  protected:
+    size_t _rows{0};
+    size_t _cols{0};
+    std::vector<size_t> _row_start{0};
+    std::vector<size_t> _col{};
+    AlignedArray<T> _data{};
+
+  public:
+    // Constructors and destructors
+    SparseMatrix(const Matrix<bool>& pattern, const T value = {})
+        : _rows(pattern.rows()),
+          _cols(pattern.cols())
+    {
+        _row_start.reserve(_rows + 1);
+        for (size_t i = 0; i < _rows; ++i)
+        {
+            for (size_t j = 0; j < _cols; ++j)
+                if (pattern(i, j))
+                    _col.push_back(j);
+            _row_start.push_back(_col.size());
+        }
+        _data = AlignedArray<T>(_col.size(), value);
+    }
+    SparseMatrix() = default;
+    SparseMatrix(const SparseMatrix<T>& other) = default;
+    SparseMatrix(SparseMatrix<T>&& other) = default;
+    ~SparseMatrix() = default;
+
+    // Assignment
+    SparseMatrix<T>& operator=(const SparseMatrix<T>& other) = default;
+    SparseMatrix<T>& operator=(SparseMatrix<T>&& other) = default;
+
+    // Getters
+    inline size_t rows() const { return _rows; }
+    inline size_t cols() const { return _cols; }
+    inline size_t nnz() const { return _col.size(); }
+
+    // Entries
+    inline size_t row_begin(const size_t i) const { check_row(i); return _row_start[i]; }
+    inline size_t row_end(const size_t i) const { check_row(i); return _row_start[i + 1]; }
+    inline size_t col(const size_t k) const { check_entry(k); return _col[k]; }
+    inline T& value(const size_t k) { check_entry(k); return _data[k]; }
+    inline const T& value(const size_t k) const { check_entry(k); return _data[k]; }
+
+    // Find the entry of (i,j) or return nnz() if it is not in the pattern
+    size_t find(const size_t i, const size_t j) const
+    {
+        const auto first = _col.begin() + row_begin(i);
+        const auto last = _col.begin() + row_end(i);
+        const auto it = std::lower_bound(first, last, j);
+        return it != last && *it == j ? static_cast<size_t>(it - _col.begin()) : nnz();
+    }
+    inline bool contains(const size_t i, const size_t j) const { return find(i, j) != nnz(); }
+
+    // Get and set elements in the pattern
+    inline const T operator()(const size_t i, const size_t j) const { return _data[find_existing(i, j)]; }
+    inline T& operator()(const size_t i, const size_t j) { return _data[find_existing(i, j)]; }
+
+  private:
+    // Bounds checks
+    inline void check_row(const size_t i) const
+    {
+#ifndef NDEBUG
+        if (i >= rows())
+        {
+            printf("Accessing sparse matrix row %lu is out of bounds\n", i);
+            std::abort();
+        }
+#else
+        (void)i;
+#endif
+    }
+    inline void check_entry(const size_t k) const
+    {
+#ifndef NDEBUG
+        if (k >= nnz())
+        {
+            printf("Accessing sparse matrix entry %lu is out of bounds\n", k);
+            std::abort();
+        }
+#else
+        (void)k;
+#endif
+    }
+    inline size_t find_existing(const size_t i, const size_t j) const
+    {
+        const auto k = find(i, j);
+        if (k == nnz())
+        {
+            printf("Accessing sparse matrix element (%lu,%lu) is not in the pattern\n", i, j);
+            std::abort();
+        }
+        return k;
+    }
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include "InstanceData.h"
+#include "Nutmeg/Nutmeg.h"
+
+// Build the cdcplp model with the allocation cost and the truck count of each client stated as element
+// constraints on the plant of the client
+static IntVar build(const InstanceData& instance, Model& model, const ElementFormulation formulation)
+{
+    // Get instance data.
+    const auto P = instance.P;
+    const auto C = instance.C;
+    const auto T = C;
+    const auto& plant_capacity = instance.plant_capacity;
+    const auto& plant_cost = instance.plant_cost;
+    const auto& client_demand = instance.client_demand;
+    const auto& allocation_cost = instance.allocation_cost;
+    const auto& vehicle_cost = instance.vehicle_cost;
+    const auto& max_distance = instance.max_distance;
+    const auto& distance = instance.distance;
+
+    // Create cost variable.
+    Int max_cost = 0;
+    for (int p = 0; p < P; ++p)
+    {
+        max_cost += plant_cost[p];
+    }
+    for (int c = 0; c < C; ++c)
+    {
+        max_cost += allocation_cost.row_max(c);
+    }
+    max_cost += C * vehicle_cost;
+    IntVar vars_cost = model.add_int_var(0, max_cost, true, "cost");
+
+    // Create variables to indicate whether a plant is open.
+    Vector<BoolVar> vars_plant_open(P);
+    for (int p = 0; p < P; ++p)
+    {
+        const auto name = fmt::format("plant_open[{}]", p);
+        vars_plant_open[p] = model.add_bool_var(name);
+    }
+
+    // Create variables for number of trucks at a plant.
+    Vector<IntVar> vars_trucks_used_at_plant(P);
+    for (int p = 0; p < P; ++p)
+    {
+        const auto name = fmt::format("nb_trucks[{}]", p);
+        vars_trucks_used_at_plant[p] = model.add_int_var(0, T, true, name);
+    }
+
+    // Create variables for the plant assigned to a client. Plants are numbered from 1 to index the
+    // arrays of the element constraints.
+    Vector<IntVar> vars_client_plant(C);
+    Vector<Vector<BoolVar>> vars_client_plant_indicator(C);
+    for (int c = 0; c < C; ++c)
+    {
+        const auto name = fmt::format("client_plant[{}]", c);
+        vars_client_plant[c] = model.add_int_var(1, P, true, name);
+        vars_client_plant_indicator[c] = model.add_indicator_vars(vars_client_plant[c]);
+    }
+
+    // Create truck number variables.
+    Vector<IntVar> vars_truck_number_of_client(C);
+    for (int c = 0; c < C; ++c)
+    {
+        const auto name = fmt::format("truck_number_of_client[{}]", c);
+        vars_truck_number_of_client[c] = model.add_int_var(0, T - 1, true, name);
+    }
+
+    // Create allocation cost variables.
+    // allocation_cost_of_client[c] = allocation_cost[c, client_plant[c]]
+    Vector<IntVar> vars_allocation_cost_of_client(C);
+    for (int c = 0; c < C; ++c)
+    {
+        const auto name = fmt::format("allocation_cost_of_client[{}]", c);
+        vars_allocation_cost_of_client[c] = model.add_int_var(allocation_cost.row_min(c),
+                                                              allocation_cost.row_max(c),
+                                                              true,
+                                                              name);
+        const Vector<Int> array(allocation_cost.begin(c), allocation_cost.end(c));
+        model.add_constr_element(vars_client_plant[c], array, vars_allocation_cost_of_client[c], formulation);
+    }
+
+    // Create variables for the number of trucks at the plant of a client.
+    // trucks_used_at_client_plant[c] = trucks_used_at_plant[client_plant[c]]
+    Vector<IntVar> vars_trucks_used_at_client_plant(C);
+    for (int c = 0; c < C; ++c)
+    {
+        const auto name = fmt::format("trucks_used_at_client_plant[{}]", c);
+        vars_trucks_used_at_client_plant[c] = model.add_int_var(0, T, true, name);
+        model.add_constr_element(vars_client_plant[c],
+                                 vars_trucks_used_at_plant,
+                                 vars_trucks_used_at_client_plant[c],
+                                 formulation);
+    }
+
+    // Create objective function.
+    {
+        IntVar open_cost = model.add_int_var(0, max_cost, true, "open_cost");
+        model.add_constr_linear(vars_plant_open, plant_cost, Sign::EQ, 0, open_cost);
+
+        Vector<IntVar> vars{open_cost};
+        Vector<Int> coeffs{1};
+        for (int c = 0; c < C; ++c)
+        {
+            vars.push_back(vars_allocation_cost_of_client[c]);
+            coeffs.push_back(1);
+        }
+        for (int p = 0; p < P; ++p)
+        {
+            vars.push_back(vars_trucks_used_at_plant[p]);
+            coeffs.push_back(vehicle_cost);
+        }
+        vars.push_back(vars_cost);
+        coeffs.push_back(-1);
+        model.add_constr_linear(vars, coeffs, Sign::EQ, 0);
+    }
+
+    // Create plant capacity constraint.
+    // sum(c in C) (client_demand[c] * [client_plant[c] == p]) <= plant_capacity[p] * plant_open[p]
+    for (int p = 0; p < P; ++p)
+    {
+        Vector<BoolVar> vars(C);
+        Vector<Int> coeffs(C);
+        for (int c = 0; c < C; ++c)
+        {
+            vars[c] = vars_client_plant_indicator[c][p];
+            coeffs[c] = client_demand[c];
+        }
+        vars.push_back(vars_plant_open[p]);
+        coeffs.push_back(-plant_capacity[p]);
+
+        model.add_constr_linear(vars, coeffs, Sign::LE, 0);
+    }
+
+    // Create truck distance constraints.
+    for (int p = 0; p < P; ++p)
+    {
+        Vector<BoolVar> active(C);
+        Vector<IntVar> start(C);
+        Vector<Int> duration(C, 1);
+        Vector<Int> resource(C);
+        for (int c = 0; c < C; ++c)
+        {
+            active[c] = vars_client_plant_indicator[c][p];
+            start[c] = vars_truck_number_of_client[c];
+            resource[c] = distance(c, p);
+        }
+        model.add_constr_cumulative_optional(active,
+                                             start,
+                                             duration,
+                                             resource,
+                                             max_distance);
+    }
+
+    // Create truck distance relaxation.
+    // sum(c in C) (distance[c,p] * [client_plant[c] == p]) <= max_distance * trucks_used_at_plant[p]
+    for (int p = 0; p < P; ++p)
+    {
+        Vector<BoolVar> vars(C);
+        Vector<Int> coeffs(C);
+        for (int c = 0; c < C; ++c)
+        {
+            vars[c] = vars_client_plant_indicator[c][p];
+            coeffs[c] = distance(c, p);
+        }
+
+        model.add_constr_linear(vars,
+                                coeffs,
+                                Sign::LE,
+                                0,
+                                vars_trucks_used_at_plant[p],
+                                max_distance);
+    }
+
+    // Calculate number of trucks used.
+    // truck_number_of_client[c] + 1 <= trucks_used_at_client_plant[c]
+    for (int c = 0; c < C; ++c)
+    {
+        model.add_constr_subtraction_leq(vars_truck_number_of_client[c], vars_trucks_used_at_client_plant[c], -1);
+    }
+
+    // Add redundant constraint.
+    // sum(c in C) ([client_plant[c] == p]) >= trucks_used_at_plant[p]
+    for (int p = 0; p < P; ++p)
+    {
+        Vector<BoolVar> vars(C);
+        Vector<Int> coeffs(C, 1);
+        for (int c = 0; c < C; ++c)
+        {
+            vars[c] = vars_client_plant_indicator[c][p];
+        }
+        model.add_constr_linear(vars, coeffs, Sign::GE, 0, vars_trucks_used_at_plant[p]);
+    }
+
+    // Done.
+    return vars_cost;
+}
+
+int main(int argc, char** argv)
+{
+    // Read instance.
+    release_assert(argc >= 2, "Path to instance must be second argument");
+    const InstanceData instance(argv[1]);
+
+    // Get time limit.
+    const auto time_limit = argc >= 3 ? std::atof(argv[2]) : Infinity;
+
+    // Solve using each formulation of the element constraints.
+    const Vector<Pair<ElementFormulation, String>> formulations{{ElementFormulation::Indicator, "indicator"},
+                                                                {ElementFormulation::ConvexHull, "convex hull"}};
+    for (const auto& [formulation, formulation_name] : formulations)
+    {
+        Model model(Method::BC);
+        const auto vars_cost = build(instance, model, formulation);
+        model.minimize(vars_cost, time_limit, false);
+
+        const auto status = model.get_status();
+        const auto has_sol = status == Status::Optimal || status == Status::Feasible;
+        println("{:>12}: status {}, LB {}, UB {}, time {:.2f} seconds",
+                formulation_name,
+                static_cast<Int>(status),
+                status != Status::Infeasible ? fmt::format("{}", model.get_dual_bound()) : "-",
+                has_sol ? fmt::format("{}", model.get_primal_bound()) : "-",
+                model.get_runtime());
+    }
+
+    // Done.
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include "Nutmeg/Includes.h"
+#include "Nutmeg/DataFile.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace Nutmeg;
+
+int main(int argc, char** argv)
+{
+    // Get the array size and the number of repetitions.
+    const Int size = argc >= 2 ? std::atoi(argv[1]) : 1000000;
+    const Int nb_repeats = argc >= 3 ? std::atoi(argv[2]) : 10;
+    release_assert(size > 0 && nb_repeats > 0, "Usage: parse_benchmark [array size] [repetitions]");
+
+    // Write a data file with a scalar, a one-dimensional array and a two-dimensional array.
+    const String file_path = "parse_benchmark.dzn";
+    {
+        auto f = fopen(file_path.c_str(), "w");
+        release_assert(f, "Cannot write data file {}", file_path);
+        std::mt19937 rng(0);
+        std::uniform_int_distribution<Int> dist(-100000, 100000);
+        const Int cols = 100;
+        fmt::print(f, "size = {} ;\n", size);
+        fmt::print(f, "array = [");
+        for (Int idx = 0; idx < size; ++idx)
+            fmt::print(f, idx == 0 ? "{}" : ", {}", dist(rng));
+        fmt::print(f, "] ;\n");
+        fmt::print(f, "matrix = [");
+        for (Int idx = 0; idx < size; ++idx)
+            fmt::print(f, idx % cols == 0 ? "|{}" : ", {}", dist(rng));
+        fmt::print(f, "|] ;\n");
+        fclose(f);
+    }
+
+    // Parse the file repeatedly.
+    const auto file_size = MappedFile(file_path).size();
+    int64_t checksum = 0;
+    const auto start_time = std::chrono::steady_clock::now();
+    for (Int repeat = 0; repeat < nb_repeats; ++repeat)
+    {
+        DznFile file(file_path);
+        Vector<Int> array(file.get_int("size"));
+        Vector<Int> matrix(array.size());
+        file.get_int_array("array", array.data(), array.size());
+        file.get_int_array("matrix", matrix.data(), matrix.size());
+        checksum += array.back() + matrix.back();
+    }
+    const auto run_time = std::chrono::duration<Float>(std::chrono::steady_clock::now() - start_time).count();
+    std::remove(file_path.c_str());
+
+    // Print.
+    const auto nb_ints = 2 * static_cast<int64_t>(size) * nb_repeats;
+    println("Parsed {} integers in {:.3f} seconds ({:.1f} MB/s, {:.1f} million integers/s, checksum {})",
+            nb_ints,
+            run_time,
+            file_size * nb_repeats / run_time / 1e6,
+            nb_ints / run_time / 1e6,
+            checksum);
+}
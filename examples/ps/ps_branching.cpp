@@ -0,0 +1,155 @@
+#include "InstanceData.h"
+#include "Nutmeg/Nutmeg.h"
+#include "Nutmeg/SparseMatrix.h"
+
+// Build the cost model of ps_cost on one instance
+static IntVar build(const InstanceData& instance, Model& model)
+{
+    // Get instance data.
+    const auto T = instance.T;
+    const auto M = instance.M;
+    const auto& cost = instance.cost;
+    const auto& duration = instance.duration;
+    const auto& resource = instance.resource;
+    const auto& release = instance.release;
+    const auto& deadline = instance.deadline;
+    const auto& capacity = instance.capacity;
+
+    // Create variables.
+    IntVar vars_cost;
+    SparseMatrix<BoolVar> vars_job_machine_assignment;
+    SparseMatrix<IntVar> vars_start;
+
+    // Calculate which assignments don't exceed the job duration.
+    Matrix<bool> is_valid(T, M, false);
+    for (int t = 0; t < T; ++t)
+        for (int m = 0; m < M; ++m)
+        {
+            const auto lb = release[t];
+            const auto ub = deadline[t] - duration(t, m);
+            is_valid(t, m) = lb <= ub;
+        }
+
+    // Create cost variable.
+    Int max_cost = 0;
+    for (int t = 0; t < T; ++t)
+    {
+        Int max_t_cost = 0;
+        for (int m = 0; m < M; ++m)
+            if (is_valid(t, m) && cost(t, m) > max_t_cost)
+                max_t_cost = cost(t, m);
+        max_cost += max_t_cost;
+    }
+    vars_cost = model.add_int_var(0, max_cost, true, "cost");
+
+    // Create assignment variables.
+    vars_job_machine_assignment = SparseMatrix<BoolVar>(is_valid);
+    for (int t = 0; t < T; ++t)
+        for (auto k = vars_job_machine_assignment.row_begin(t); k < vars_job_machine_assignment.row_end(t); ++k)
+        {
+            const auto m = vars_job_machine_assignment.col(k);
+            const auto name = fmt::format("assign[{},{}]", t, m);
+            vars_job_machine_assignment.value(k) = model.add_bool_var(name);
+        }
+
+    // Create start time variables.
+    vars_start = SparseMatrix<IntVar>(is_valid);
+    for (int t = 0; t < T; ++t)
+        for (auto k = vars_start.row_begin(t); k < vars_start.row_end(t); ++k)
+        {
+            const auto m = vars_start.col(k);
+            const auto lb = release[t];
+            const auto ub = deadline[t] - duration(t, m);
+            const auto name = fmt::format("start[{},{}]", t, m);
+            vars_start.value(k) = model.add_int_var(lb, ub, false, name);
+        }
+
+    // Create objective function.
+    {
+        Vector<BoolVar> vars;
+        Vector<Int> coeffs;
+        for (int t = 0; t < T; ++t)
+            for (auto k = vars_job_machine_assignment.row_begin(t); k < vars_job_machine_assignment.row_end(t); ++k)
+            {
+                const auto m = vars_job_machine_assignment.col(k);
+                vars.push_back(vars_job_machine_assignment.value(k));
+                coeffs.push_back(cost(t, m));
+            }
+        model.add_constr_linear(vars, coeffs, Sign::EQ, 0, vars_cost);
+    }
+
+    // Create assignment constraints.
+    for (int t = 0; t < T; ++t)
+    {
+        Vector<BoolVar> vars;
+        for (auto k = vars_job_machine_assignment.row_begin(t); k < vars_job_machine_assignment.row_end(t); ++k)
+            vars.push_back(vars_job_machine_assignment.value(k));
+        model.add_constr_set_partition(vars);
+    }
+
+    // Create scheduling constraints.
+    for (int m = 0; m < M; ++m)
+    {
+        Vector<BoolVar> loc_active;
+        Vector<IntVar> loc_start;
+        Vector<Int> loc_duration;
+        Vector<Int> loc_resource;
+        for (int t = 0; t < T; ++t)
+            if (is_valid(t, m))
+            {
+                loc_active.push_back(vars_job_machine_assignment(t, m));
+                loc_start.push_back(vars_start(t, m));
+                loc_duration.push_back(duration(t, m));
+                loc_resource.push_back(resource(t, m));
+            }
+
+        model.add_constr_cumulative_optional(loc_active,
+                                             loc_start,
+                                             loc_duration,
+                                             loc_resource,
+                                             capacity[m]);
+    }
+
+    // Done.
+    return vars_cost;
+}
+
+// Solve with a branching rule turned on or off and print the result
+static void solve(const InstanceData& instance, const Float time_limit, const bool use_cp_activity)
+{
+    Model model(Method::BC);
+    const auto vars_cost = build(instance, model);
+    if (!use_cp_activity)
+    {
+        scip_assert(SCIPsetIntParam(model.mip(), "branching/cpactivity/priority", -1000000));
+    }
+    model.minimize(vars_cost, time_limit, false);
+
+    const auto status = model.get_status();
+    const auto has_sol = status == Status::Optimal || status == Status::Feasible;
+    println("{:>12}: status {}, LB {}, UB {}, nodes {}, time {:.2f} seconds",
+            use_cp_activity ? "cp activity" : "default",
+            static_cast<Int>(status),
+            status != Status::Infeasible ? fmt::format("{}", model.get_dual_bound()) : "-",
+            has_sol ? fmt::format("{}", model.get_primal_bound()) : "-",
+            SCIPgetNNodes(model.mip()),
+            model.get_runtime());
+}
+
+int main(int argc, char** argv)
+{
+    // Read instance.
+    release_assert(argc >= 2, "Path to instance must be second argument");
+    const InstanceData instance(argv[1]);
+
+    // Get time limit.
+    const auto time_limit = argc >= 3 ? std::atof(argv[2]) : Infinity;
+
+    // Solve with the default branching rules of SCIP and with branching on the activity of variables in
+    // CP nogoods.
+    solve(instance, time_limit, false);
+    solve(instance, time_limit, true);
+
+    // Done.
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include "InstanceData.h"
 #include "Nutmeg/Nutmeg.h"
+#include "Nutmeg/SparseMatrix.h"
 
 int main(int argc, char** argv)
 {
@@ -33,8 +34,8 @@ int main(int argc, char** argv)
     err("Unspecified solving method");
 #endif
     IntVar vars_cost;
-    Matrix<BoolVar> vars_job_machine_assignment;
-    Matrix<IntVar> vars_start;
+    SparseMatrix<BoolVar> vars_job_machine_assignment;
+    SparseMatrix<IntVar> vars_start;
 
     // Calculate which assignments don't exceed the job duration.
     Matrix<bool> is_valid(T, M, false);
@@ -59,38 +60,38 @@ int main(int argc, char** argv)
     vars_cost = model.add_int_var(0, max_cost, true, "cost");
 
     // Create assignment variables.
-    vars_job_machine_assignment.clear_and_resize(T, M);
+    vars_job_machine_assignment = SparseMatrix<BoolVar>(is_valid);
     for (int t = 0; t < T; ++t)
-        for (int m = 0; m < M; ++m)
-            if (is_valid(t, m))
-            {
-                const auto name = fmt::format("assign[{},{}]", t, m);
-                vars_job_machine_assignment(t, m) = model.add_bool_var(name);
-            }
+        for (auto k = vars_job_machine_assignment.row_begin(t); k < vars_job_machine_assignment.row_end(t); ++k)
+        {
+            const auto m = vars_job_machine_assignment.col(k);
+            const auto name = fmt::format("assign[{},{}]", t, m);
+            vars_job_machine_assignment.value(k) = model.add_bool_var(name);
+        }
 
     // Create start time variables.
-    vars_start.clear_and_resize(T, M);
+    vars_start = SparseMatrix<IntVar>(is_valid);
     for (int t = 0; t < T; ++t)
-        for (int m = 0; m < M; ++m)
-            if (is_valid(t, m))
-            {
-                const auto lb = release[t];
-                const auto ub = deadline[t] - duration(t, m);
-                const auto name = fmt::format("start[{},{}]", t, m);
-                vars_start(t, m) = model.add_int_var(lb, ub, false, name);
-            }
+        for (auto k = vars_start.row_begin(t); k < vars_start.row_end(t); ++k)
+        {
+            const auto m = vars_start.col(k);
+            const auto lb = release[t];
+            const auto ub = deadline[t] - duration(t, m);
+            const auto name = fmt::format("start[{},{}]", t, m);
+            vars_start.value(k) = model.add_int_var(lb, ub, false, name);
+        }
 
     // Create objective function.
     {
         Vector<BoolVar> vars;
         Vector<Int> coeffs;
         for (int t = 0; t < T; ++t)
-            for (int m = 0; m < M; ++m)
-                if (is_valid(t, m))
-                {
-                    vars.push_back(vars_job_machine_assignment(t, m));
-                    coeffs.push_back(cost(t, m));
-                }
+            for (auto k = vars_job_machine_assignment.row_begin(t); k < vars_job_machine_assignment.row_end(t); ++k)
+            {
+                const auto m = vars_job_machine_assignment.col(k);
+                vars.push_back(vars_job_machine_assignment.value(k));
+                coeffs.push_back(cost(t, m));
+            }
         model.add_constr_linear(vars, coeffs, Sign::EQ, 0, vars_cost);
     }
 
@@ -98,9 +99,8 @@ int main(int argc, char** argv)
     for (int t = 0; t < T; ++t)
     {
         Vector<BoolVar> vars;
-        for (int m = 0; m < M; ++m)
-            if (is_valid(t, m))
-                vars.push_back(vars_job_machine_assignment(t, m));
+        for (auto k = vars_job_machine_assignment.row_begin(t); k < vars_job_machine_assignment.row_end(t); ++k)
+            vars.push_back(vars_job_machine_assignment.value(k));
         model.add_constr_set_partition(vars);
     }
 
@@ -127,6 +127,46 @@ int main(int argc, char** argv)
                                              capacity[m]);
     }
 
+    // Declare groups of identical machines interchangeable.
+    {
+        Vector<bool> is_grouped(M, false);
+        for (int m = 0; m < M; ++m)
+            if (!is_grouped[m])
+            {
+                Vector<int> group{m};
+                for (int m2 = m + 1; m2 < M; ++m2)
+                {
+                    bool is_identical = !is_grouped[m2] && capacity[m2] == capacity[m];
+                    for (int t = 0; t < T && is_identical; ++t)
+                    {
+                        is_identical = is_valid(t, m2) == is_valid(t, m) &&
+                                       cost(t, m2) == cost(t, m) &&
+                                       duration(t, m2) == duration(t, m) &&
+                                       resource(t, m2) == resource(t, m);
+                    }
+                    if (is_identical)
+                    {
+                        group.push_back(m2);
+                        is_grouped[m2] = true;
+                    }
+                }
+
+                if (group.size() > 1)
+                {
+                    Vector<Vector<BoolVar>> group_active(group.size());
+                    Vector<Vector<IntVar>> group_start(group.size());
+                    for (size_t k = 0; k < group.size(); ++k)
+                        for (int t = 0; t < T; ++t)
+                            if (is_valid(t, group[k]))
+                            {
+                                group_active[k].push_back(vars_job_machine_assignment(t, group[k]));
+                                group_start[k].push_back(vars_start(t, group[k]));
+                            }
+                    model.add_symmetry(group_active, group_start);
+                }
+            }
+    }
+
     // Solve.
     model.minimize(vars_cost, time_limit);
 
@@ -1,5 +1,6 @@
 #include "InstanceData.h"
 #include "Nutmeg/Nutmeg.h"
+#include "Nutmeg/SparseMatrix.h"
 
 int main(int argc, char** argv)
 {
@@ -34,7 +35,7 @@ int main(int argc, char** argv)
 #endif
     IntVar vars_cost;
     Vector<Vector<BoolVar>> vars_job_machine_assignment;
-    Matrix<IntVar> vars_start;
+    SparseMatrix<IntVar> vars_start;
 
     // Calculate which assignments don't exceed the job duration.
     Matrix<bool> is_valid(T, M, false);
@@ -71,16 +72,16 @@ int main(int argc, char** argv)
     }
 
     // Create start time variables.
-    vars_start.clear_and_resize(T, M);
+    vars_start = SparseMatrix<IntVar>(is_valid);
     for (int t = 0; t < T; ++t)
-        for (int m = 0; m < M; ++m)
-            if (is_valid(t, m))
-            {
-                const auto lb = release[t];
-                const auto ub = deadline[t] - duration(t, m);
-                const auto name = fmt::format("start[{},{}]", t, m);
-                vars_start(t, m) = model.add_int_var(lb, ub, false, name);
-            }
+        for (auto k = vars_start.row_begin(t); k < vars_start.row_end(t); ++k)
+        {
+            const auto m = vars_start.col(k);
+            const auto lb = release[t];
+            const auto ub = deadline[t] - duration(t, m);
+            const auto name = fmt::format("start[{},{}]", t, m);
+            vars_start.value(k) = model.add_int_var(lb, ub, false, name);
+        }
 
     // Create objective function.
     {
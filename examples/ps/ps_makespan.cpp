@@ -1,5 +1,6 @@
 #include "InstanceData.h"
 #include "Nutmeg/Nutmeg.h"
+#include "Nutmeg/SparseMatrix.h"
 
 int main(int argc, char** argv)
 {
@@ -32,8 +33,8 @@ int main(int argc, char** argv)
     err("Unspecified solving method");
 #endif
     IntVar vars_makespan;
-    Matrix<BoolVar> vars_job_machine_assignment;
-    Matrix<IntVar> vars_start;
+    SparseMatrix<BoolVar> vars_job_machine_assignment;
+    SparseMatrix<IntVar> vars_start;
 
     // Calculate which assignments don't exceed the job duration.
     Matrix<bool> is_valid(T, M, false);
@@ -53,26 +54,26 @@ int main(int argc, char** argv)
     vars_makespan = model.add_int_var(0, max_makespan, true, "makespan");
 
     // Create assignment variables.
-    vars_job_machine_assignment.clear_and_resize(T, M);
+    vars_job_machine_assignment = SparseMatrix<BoolVar>(is_valid);
     for (int t = 0; t < T; ++t)
-        for (int m = 0; m < M; ++m)
-            if (is_valid(t, m))
-            {
-                const auto name = fmt::format("assign[{},{}]", t, m);
-                vars_job_machine_assignment(t, m) = model.add_bool_var(name);
-            }
+        for (auto k = vars_job_machine_assignment.row_begin(t); k < vars_job_machine_assignment.row_end(t); ++k)
+        {
+            const auto m = vars_job_machine_assignment.col(k);
+            const auto name = fmt::format("assign[{},{}]", t, m);
+            vars_job_machine_assignment.value(k) = model.add_bool_var(name);
+        }
 
     // Create start time variables.
-    vars_start.clear_and_resize(T, M);
+    vars_start = SparseMatrix<IntVar>(is_valid);
     for (int t = 0; t < T; ++t)
-        for (int m = 0; m < M; ++m)
-            if (is_valid(t, m))
-            {
-                const auto lb = release[t];
-                const auto ub = deadline[t] - duration(t, m);
-                const auto name = fmt::format("start[{},{}]", t, m);
-                vars_start(t, m) = model.add_int_var(lb, ub, false, name);
-            }
+        for (auto k = vars_start.row_begin(t); k < vars_start.row_end(t); ++k)
+        {
+            const auto m = vars_start.col(k);
+            const auto lb = release[t];
+            const auto ub = deadline[t] - duration(t, m);
+            const auto name = fmt::format("start[{},{}]", t, m);
+            vars_start.value(k) = model.add_int_var(lb, ub, false, name);
+        }
 
     // Create makespan constraints.
     for (int t = 0; t < T; ++t)
@@ -93,9 +94,8 @@ int main(int argc, char** argv)
     for (int t = 0; t < T; ++t)
     {
         Vector<BoolVar> vars;
-        for (int m = 0; m < M; ++m)
-            if (is_valid(t, m))
-                vars.push_back(vars_job_machine_assignment(t, m));
+        for (auto k = vars_job_machine_assignment.row_begin(t); k < vars_job_machine_assignment.row_end(t); ++k)
+            vars.push_back(vars_job_machine_assignment.value(k));
         model.add_constr_set_partition(vars);
     }
 
@@ -0,0 +1,263 @@
+#include "InstanceData.h"
+#include "Nutmeg/Nutmeg.h"
+#include "Nutmeg/SparseMatrix.h"
+#include "Nutmeg/BatchSolver.h"
+#include "Nutmeg/ModelPool.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <thread>
+
+struct Result
+{
+    Status status{Status::Unknown};
+    Int obj{0};
+};
+
+// Build the cost model of ps_cost on one instance
+static IntVar build(const String& instance_file_path, Model& model)
+{
+    // Read instance.
+    const InstanceData instance(instance_file_path);
+
+    // Get instance data.
+    const auto T = instance.T;
+    const auto M = instance.M;
+    const auto& cost = instance.cost;
+    const auto& duration = instance.duration;
+    const auto& resource = instance.resource;
+    const auto& release = instance.release;
+    const auto& deadline = instance.deadline;
+    const auto& capacity = instance.capacity;
+
+    // Create variables.
+    IntVar vars_cost;
+    SparseMatrix<BoolVar> vars_job_machine_assignment;
+    SparseMatrix<IntVar> vars_start;
+
+    // Calculate which assignments don't exceed the job duration.
+    Matrix<bool> is_valid(T, M, false);
+    for (int t = 0; t < T; ++t)
+        for (int m = 0; m < M; ++m)
+        {
+            const auto lb = release[t];
+            const auto ub = deadline[t] - duration(t, m);
+            is_valid(t, m) = lb <= ub;
+        }
+
+    // Create cost variable.
+    Int max_cost = 0;
+    for (int t = 0; t < T; ++t)
+    {
+        Int max_t_cost = 0;
+        for (int m = 0; m < M; ++m)
+            if (is_valid(t, m) && cost(t, m) > max_t_cost)
+                max_t_cost = cost(t, m);
+        max_cost += max_t_cost;
+    }
+    vars_cost = model.add_int_var(0, max_cost, true, "cost");
+
+    // Create assignment variables.
+    vars_job_machine_assignment = SparseMatrix<BoolVar>(is_valid);
+    for (int t = 0; t < T; ++t)
+        for (auto k = vars_job_machine_assignment.row_begin(t); k < vars_job_machine_assignment.row_end(t); ++k)
+        {
+            const auto m = vars_job_machine_assignment.col(k);
+            const auto name = fmt::format("assign[{},{}]", t, m);
+            vars_job_machine_assignment.value(k) = model.add_bool_var(name);
+        }
+
+    // Create start time variables.
+    vars_start = SparseMatrix<IntVar>(is_valid);
+    for (int t = 0; t < T; ++t)
+        for (auto k = vars_start.row_begin(t); k < vars_start.row_end(t); ++k)
+        {
+            const auto m = vars_start.col(k);
+            const auto lb = release[t];
+            const auto ub = deadline[t] - duration(t, m);
+            const auto name = fmt::format("start[{},{}]", t, m);
+            vars_start.value(k) = model.add_int_var(lb, ub, false, name);
+        }
+
+    // Create objective function.
+    {
+        Vector<BoolVar> vars;
+        Vector<Int> coeffs;
+        for (int t = 0; t < T; ++t)
+            for (auto k = vars_job_machine_assignment.row_begin(t); k < vars_job_machine_assignment.row_end(t); ++k)
+            {
+                const auto m = vars_job_machine_assignment.col(k);
+                vars.push_back(vars_job_machine_assignment.value(k));
+                coeffs.push_back(cost(t, m));
+            }
+        model.add_constr_linear(vars, coeffs, Sign::EQ, 0, vars_cost);
+    }
+
+    // Create assignment constraints.
+    for (int t = 0; t < T; ++t)
+    {
+        Vector<BoolVar> vars;
+        for (auto k = vars_job_machine_assignment.row_begin(t); k < vars_job_machine_assignment.row_end(t); ++k)
+            vars.push_back(vars_job_machine_assignment.value(k));
+        model.add_constr_set_partition(vars);
+    }
+
+    // Create scheduling constraints.
+    for (int m = 0; m < M; ++m)
+    {
+        Vector<BoolVar> loc_active;
+        Vector<IntVar> loc_start;
+        Vector<Int> loc_duration;
+        Vector<Int> loc_resource;
+        for (int t = 0; t < T; ++t)
+            if (is_valid(t, m))
+            {
+                loc_active.push_back(vars_job_machine_assignment(t, m));
+                loc_start.push_back(vars_start(t, m));
+                loc_duration.push_back(duration(t, m));
+                loc_resource.push_back(resource(t, m));
+            }
+
+        model.add_constr_cumulative_optional(loc_active,
+                                             loc_start,
+                                             loc_duration,
+                                             loc_resource,
+                                             capacity[m]);
+    }
+
+    // Done.
+    return vars_cost;
+}
+
+// Build and solve the cost model of ps_cost on one instance in an empty model
+static Result solve(Model& model, const String& instance_file_path, const Float time_limit)
+{
+    // Solve.
+    const auto vars_cost = build(instance_file_path, model);
+    model.minimize(vars_cost, time_limit, false);
+
+    // Return result.
+    Result result;
+    result.status = model.get_status();
+    if (result.status == Status::Optimal || result.status == Status::Feasible)
+    {
+        result.obj = model.get_primal_bound();
+    }
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    // Get arguments.
+    release_assert(argc >= 2, "Path to instances directory must be second argument");
+    const String instances_dir = argv[1];
+    const size_t nb_instances = argc >= 3 ? std::atoi(argv[2]) : 16;
+    const size_t nb_threads = argc >= 4 ? std::atoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+    const auto time_limit = argc >= 5 ? std::atof(argv[4]) : Infinity;
+
+    // Get instances.
+    Vector<String> instances;
+    for (const auto& entry : std::filesystem::directory_iterator(instances_dir))
+        if (entry.path().extension() == ".dzn")
+        {
+            instances.push_back(entry.path().string());
+        }
+    std::sort(instances.begin(), instances.end());
+    if (instances.size() > nb_instances)
+    {
+        instances.resize(nb_instances);
+    }
+    release_assert(!instances.empty(), "No instances found in {}", instances_dir);
+
+    // Solve serially, reusing one model for every instance.
+    Vector<Result> serial_results(instances.size());
+    {
+        ModelPool pool;
+        for (size_t idx = 0; idx < instances.size(); ++idx)
+        {
+            auto model = pool.acquire(Method::BC);
+            serial_results[idx] = solve(*model, instances[idx], time_limit);
+            pool.release(std::move(model));
+        }
+    }
+
+    // Solve in parallel.
+    Vector<Result> parallel_results(instances.size());
+    {
+        std::atomic<size_t> next_idx{0};
+        Vector<std::thread> threads;
+        for (size_t thread_idx = 0; thread_idx < nb_threads; ++thread_idx)
+        {
+            threads.emplace_back([&]()
+            {
+                for (auto idx = next_idx++; idx < instances.size(); idx = next_idx++)
+                {
+                    Model model(Method::BC);
+                    parallel_results[idx] = solve(model, instances[idx], time_limit);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    // Solve with the batch solver.
+    Vector<Result> batch_results(instances.size());
+    {
+        BatchSolver batch(nb_threads);
+        for (const auto& instance : instances)
+        {
+            // Predict the run time from the number of task-machine pairs without building the model.
+            const InstanceData instance_data(instance);
+            const auto predicted_cost = static_cast<Float>(instance_data.T) * static_cast<Float>(instance_data.M);
+            batch.add_job(instance,
+                          [&instance](Model& model) { return build(instance, model); },
+                          time_limit,
+                          Method::BC,
+                          predicted_cost);
+        }
+        batch.run([&](const BatchResult& batch_result, Model&)
+        {
+            auto& result = batch_results[batch_result.job_idx];
+            result.status = batch_result.status;
+            if (result.status == Status::Optimal || result.status == Status::Feasible)
+            {
+                result.obj = batch_result.primal_bound;
+            }
+            println("Finished {} in {:.2f} seconds (predicted cost {})",
+                    batch_result.name, batch_result.run_time, batch_result.predicted_cost);
+        });
+    }
+
+    // Compare results. Runs stopped by the time limit can legitimately differ.
+    auto is_match = [](const Result& a, const Result& b)
+    {
+        const auto timed_out = a.status == Status::Unknown || a.status == Status::Feasible ||
+                               b.status == Status::Unknown || b.status == Status::Feasible;
+        return timed_out || (a.status == b.status && a.obj == b.obj);
+    };
+    Int nb_mismatches = 0;
+    for (size_t idx = 0; idx < instances.size(); ++idx)
+    {
+        const auto& serial = serial_results[idx];
+        const auto& parallel = parallel_results[idx];
+        const auto& batch = batch_results[idx];
+        const auto matches = is_match(serial, parallel) && is_match(serial, batch);
+        println("{}: serial {} {}, parallel {} {}, batch {} {}{}",
+                instances[idx],
+                static_cast<Int>(serial.status),
+                serial.obj,
+                static_cast<Int>(parallel.status),
+                parallel.obj,
+                static_cast<Int>(batch.status),
+                batch.obj,
+                matches ? "" : " MISMATCH");
+        nb_mismatches += !matches;
+    }
+    println("Solved {} instances on {} threads with {} mismatches", instances.size(), nb_threads, nb_mismatches);
+
+    // Done.
+    return nb_mismatches == 0 ? 0 : 1;
+}
@@ -1,74 +1,15 @@
 #include "InstanceData.h"
-#include <fstream>
-#include <sstream>
-#include <regex>
-
-static inline Vector<String> read_file(const String& instance_file_path)
-{
-    Vector<String> lines;
-
-    // Open the file.
-    std::ifstream f(instance_file_path);
-    if (!f)
-    {
-        err("Cannot open data file {}", instance_file_path);
-    }
-
-    // Read the file.
-    {
-        String line;
-        while (std::getline(f, line))
-            lines.push_back(line);
-    }
-
-    // Return.
-    return lines;
-}
-
-static inline Vector<String> split_string(const String& input, const char delim)
-{
-    Vector<String> array_of_strings;
-    {
-        std::stringstream ss(input);
-        String token;
-        while (std::getline(ss, token, delim))
-            array_of_strings.push_back(token);
-    }
-    return array_of_strings;
-}
+#include "Nutmeg/DataFile.h"
 
 InstanceData::InstanceData(const String& instance_file_path)
 {
     // Read the file.
-    Vector<String> lines = read_file(instance_file_path);
+    DznFile file(instance_file_path);
 
     // Read size.
-    for (size_t l = 0; l < lines.size() && lines[l].length() > 0; l++)
-    {
-        const auto& line = lines[l];
-
-        // (\w+)\s*=\s*(.+)\s*;
-        std::regex r("(\\w+)\\s*=\\s*(.+)\\s*;");
-        std::smatch sm;
-        if (std::regex_search(line, sm, r))
-        {
-            const auto name = sm[1].str();
-            const auto val_str = sm[2].str();
-
-            if (name == "n_tasks")
-            {
-                num_jobs = std::atoi(val_str.c_str());
-            }
-            else if (name == "n_res")
-            {
-                num_resources = std::atoi(val_str.c_str());
-            }
-            else if (name == "t_max")
-            {
-                time_horizon = std::atoi(val_str.c_str());
-            }
-        }
-    }
+    num_jobs = file.get_int("n_tasks");
+    num_resources = file.get_int("n_res");
+    time_horizon = file.get_int("t_max");
 
     // Allocate memory.
     resource_availability.resize(num_resources);
@@ -77,142 +18,24 @@ InstanceData::InstanceData(const String& instance_file_path)
     job_duedate.resize(num_jobs);
     job_earliness_cost.resize(num_jobs);
     job_tardiness_cost.resize(num_jobs);
-    job_successors.resize(num_jobs);
 
     // Read remaining data.
-    for (size_t l = 0; l < lines.size() && lines[l].length() > 0; l++)
+    file.get_int_array("d", job_duration.data(), num_jobs);
+    file.get_int_array("rr", job_consumption.begin(0), num_resources * num_jobs);
+    file.get_int_array("rc", resource_availability.data(), num_resources);
+    job_successors = file.get_int_set_array("suc");
+    release_assert(static_cast<Int>(job_successors.size()) == num_jobs,
+                   "Data file {} has {} successor lists but {} jobs",
+                   instance_file_path, job_successors.size(), num_jobs);
     {
-        const auto& line = lines[l];
-
-        // (\w+)\s*=\s*(.+)\s*;
-        std::regex r("(\\w+)\\s*=\\s*(.+)\\s*;");
-        std::smatch sm;
-        if (std::regex_search(line, sm, r))
+        // Each row holds the due date, earliness cost and tardiness cost.
+        Vector<Int> deadline(3 * num_jobs);
+        file.get_int_array("deadline", deadline.data(), deadline.size());
+        for (Int j = 0; j < num_jobs; ++j)
         {
-            const auto name = sm[1].str();
-            auto val_str = sm[2].str();
-
-            if (name == "d")
-            {
-                auto it = job_duration.begin();
-                std::regex r("(\\d+)");
-                std::smatch sm;
-                while (std::regex_search(val_str, sm, r))
-                {
-                    for (size_t i = 1; i < sm.size(); ++i)
-                    {
-                        *it = std::atoi(sm[i].str().c_str());
-                        ++it;
-                    }
-                    val_str = sm.suffix();
-                }
-            }
-            else if (name == "rr")
-            {
-                auto it = job_consumption.begin(0);
-                std::regex r("(\\d+)");
-                std::smatch sm;
-                while (std::regex_search(val_str, sm, r))
-                {
-                    for (size_t i = 1; i < sm.size(); ++i)
-                    {
-                        *it = std::atoi(sm[i].str().c_str());
-                        ++it;
-                    }
-                    val_str = sm.suffix();
-                }
-            }
-            else if (name == "rc")
-            {
-                auto it = resource_availability.begin();
-                std::regex r("(\\d+)");
-                std::smatch sm;
-                while (std::regex_search(val_str, sm, r))
-                {
-                    for (size_t i = 1; i < sm.size(); ++i)
-                    {
-                        *it = std::atoi(sm[i].str().c_str());
-                        ++it;
-                    }
-                    val_str = sm.suffix();
-                }
-            }
-            else if (name == "suc")
-            {
-                int job = 0;
-                size_t pos;
-                String list;
-                while ((pos = val_str.find("},{")) != String::npos)
-                {
-                    list = val_str.substr(0, pos);
-//                    println("{{{}}}", list);
-                    val_str.erase(0, pos + 3);
-
-                    std::regex r("(\\d+)");
-                    std::smatch sm;
-                    while (std::regex_search(list, sm, r))
-                    {
-                        for (size_t i = 1; i < sm.size(); ++i)
-                        {
-                            job_successors[job].push_back(std::atoi(sm[i].str().c_str()));
-                        }
-                        list = sm.suffix();
-                    }
-
-                    ++job;
-                }
-                if ((pos = val_str.find("}")) != String::npos)
-                {
-                    list = val_str.substr(0, pos);
-//                    println("{{{}}}", list);
-
-                    std::regex r("(\\d+)");
-                    std::smatch sm;
-                    while (std::regex_search(list, sm, r))
-                    {
-                        for (size_t i = 1; i < sm.size(); ++i)
-                        {
-                            job_successors[job].push_back(std::atoi(sm[i].str().c_str()));
-                        }
-                        list = sm.suffix();
-                    }
-                }
-            }
-            else if (name == "deadline")
-            {
-                auto it1 = job_duedate.begin();
-                auto it2 = job_earliness_cost.begin();
-                auto it3 = job_tardiness_cost.begin();
-                std::regex r("(\\d+)");
-                std::smatch sm;
-
-                int it_idx = 1;
-                while (std::regex_search(val_str, sm, r))
-                {
-                    for (size_t i = 1; i < sm.size(); ++i)
-                    {
-                        if (it_idx == 1)
-                        {
-                            *it1 = std::atoi(sm[i].str().c_str());
-                            ++it1;
-                            it_idx = 2;
-                        }
-                        else if (it_idx == 2)
-                        {
-                            *it2 = std::atoi(sm[i].str().c_str());
-                            ++it2;
-                            it_idx = 3;
-                        }
-                        else
-                        {
-                            *it3 = std::atoi(sm[i].str().c_str());
-                            ++it3;
-                            it_idx = 1;
-                        }
-                    }
-                    val_str = sm.suffix();
-                }
-            }
+            job_duedate[j] = deadline[3 * j];
+            job_earliness_cost[j] = deadline[3 * j + 1];
+            job_tardiness_cost[j] = deadline[3 * j + 2];
         }
     }
 
@@ -70,7 +70,7 @@ int main(int argc, char** argv)
     for (int r = 0; r < num_resources; ++r)
     {
         Vector<Int> consumption(job_consumption.begin(r), job_consumption.end(r));
-        model.add_constr_cumulative(vars_start, job_duration, consumption, resource_availability[r], true);
+        model.add_constr_cumulative(vars_start, job_duration, consumption, resource_availability[r], true, true);
     }
 
     // Create objective function.
@@ -1,6 +1,6 @@
 #include "InstanceData.h"
-#include <fstream>
-#include <sstream>
+#include "Nutmeg/DataFile.h"
+#include <algorithm>
 
 static String trim(String& s)
 {
@@ -27,87 +27,84 @@ static inline String fix_instance_name(const String& str)
     return instance_name;
 }
 
-static inline Vector<String> read_file(const String& instance_file_path)
+static inline StringView next_nonempty_line(Tokenizer& lines)
 {
-    Vector<String> lines;
-
-    // Open the file.
-    std::ifstream f(instance_file_path);
-    if (!f)
-    {
-        err("Cannot open instance file {}", instance_file_path);
-    }
-
-    // Read the file.
-    {
-        String line;
-        while (std::getline(f, line))
-            lines.push_back(line);
-    }
+    StringView line;
+    while (line.empty() && !lines.at_end())
+        line = lines.next_line();
+    return line;
+}
 
-    // Return.
-    return lines;
+template<size_t N>
+static inline Array<StringView, N> read_columns(const StringView line)
+{
+    Array<StringView, N> vals;
+    Tokenizer tokenizer(line);
+    for (auto& val : vals)
+        val = tokenizer.next_token();
+    return vals;
 }
 
-static inline Vector<String> split_string(const String& input, const char delim)
+template<size_t N>
+static inline size_t find_column(const Array<StringView, N>& heading, const StringView name)
 {
-    Vector<String> array_of_strings;
+    const auto index = std::find(heading.cbegin(), heading.cend(), name);
+    if (index == heading.cend())
     {
-        std::stringstream ss(input);
-        String token;
-        while (std::getline(ss, token, delim))
-            array_of_strings.push_back(token);
+        err("Cannot find {} column in instance file", name);
     }
-    return array_of_strings;
+    return index - heading.cbegin();
 }
 
 InstanceData::InstanceData(const String& instance_file_path)
 {
     // Read the file.
-    Vector<String> lines = read_file(instance_file_path);
-    size_t i = 0;
+    MappedFile file(instance_file_path);
+    Tokenizer lines(file.view());
+    StringView line;
 
     // Read parameters.
     Time T = 0;
     {
         // Go to the first line with data.
-        while (i < lines.size() && lines[i].length() == 0)
-            ++i;
-        if (i == lines.size())
+        line = next_nonempty_line(lines);
+        if (line.empty())
         {
             err("Data file {} is empty", instance_file_path);
         }
 
         // Read parameters.
-        for (; i < lines.size() && lines[i].length() > 0; i++)
+        for (; !line.empty(); line = lines.next_line())
         {
             // Split the string into parameter name and value.
-            Vector<String> str = split_string(lines[i], ':');
-            if (str.size() != 2)
+            const auto colon = line.find(':');
+            if (colon == StringView::npos || line.find(':', colon + 1) != StringView::npos)
             {
                 err("Data file {} has invalid parameters section (multiple colons)", instance_file_path);
             }
+            const auto name = line.substr(0, colon);
+            const auto val = line.substr(colon + 1);
 
             // Read the parameter.
-            if (str[0] == "DataName" || str[0] == "InstanceName")
+            if (name == "DataName" || name == "InstanceName")
             {
-                instance_name = fix_instance_name(str[1]);
+                instance_name = fix_instance_name(String(val));
             }
-            else if (str[0] == "T")
+            else if (name == "T")
             {
-                T = atoi(str[1].c_str());
+                T = parse_int(val);
             }
-            else if (str[0] == "C")
+            else if (name == "C")
             {
-                C = atoi(str[1].c_str());
+                C = parse_int(val);
             }
-            else if (str[0] == "Q")
+            else if (name == "Q")
             {
-                Q = atoi(str[1].c_str());
+                Q = parse_int(val);
             }
-            else if (str[0] != "R" && str[0] != "ResourceType")
+            else if (name != "R" && name != "ResourceType")
             {
-                err("Data file {} has unknown parameter {}", instance_file_path, str[0]);
+                err("Data file {} has unknown parameter {}", instance_file_path, name);
             }
         }
     }
@@ -115,58 +112,21 @@ InstanceData::InstanceData(const String& instance_file_path)
     // Read locations.
     {
         // Go to the next line with data.
-        while (lines[i].length() == 0)
-            i++;
+        line = next_nonempty_line(lines);
 
         // Read locations table heading row.
-        size_t l_col = 0;
-        size_t x_col = 0;
-        size_t y_col = 0;
-        {
-            std::stringstream ss(lines[i]);
-
-            Vector<String> vals(3);
-            for (size_t j = 0; ss.good() && j < 3; j++)
-                ss >> vals[j];
-
-            {
-                const auto index = find(vals.cbegin(), vals.cend(), "L");
-                if (index == vals.cend())
-                {
-                    err("Cannot find L column in instance file");
-                }
-                l_col = index - vals.cbegin();
-            }
-            {
-                const auto index = find(vals.cbegin(), vals.cend(), "X");
-                if (index == vals.cend())
-                {
-                    err("Cannot find X column in instance file");
-                }
-                x_col = index - vals.cbegin();
-            }
-            {
-                const auto index = find(vals.cbegin(), vals.cend(), "Y");
-                if (index == vals.cend())
-                {
-                    err("Cannot find Y column in instance file");
-                }
-                y_col = index - vals.cbegin();
-            }
-        }
+        const auto heading = read_columns<3>(line);
+        const auto l_col = find_column(heading, "L");
+        const auto x_col = find_column(heading, "X");
+        const auto y_col = find_column(heading, "Y");
 
         // Read locations table.
-        for (i++; i < lines.size() && lines[i].length() > 0; i++)
+        for (line = lines.next_line(); !line.empty(); line = lines.next_line())
         {
-            std::stringstream ss(lines[i]);
-
-            Vector<String> vals(3);
-            for (size_t j = 0; ss.good() && j < 3; j++)
-                ss >> vals[j];
-
-            loc_name.push_back(move(vals[l_col]));
-            loc_x.push_back(atoi(vals[x_col].c_str()));
-            loc_y.push_back(atoi(vals[y_col].c_str()));
+            const auto vals = read_columns<3>(line);
+            loc_name.emplace_back(vals[l_col]);
+            loc_x.push_back(parse_int(vals[x_col]));
+            loc_y.push_back(parse_int(vals[y_col]));
         }
     }
     L = static_cast<LocationNumber>(loc_name.size());
@@ -182,89 +142,28 @@ InstanceData::InstanceData(const String& instance_file_path)
     }
     {
         // Find next line with data.
-        while (lines[i].length() == 0)
-            i++;
+        line = next_nonempty_line(lines);
 
         // Read requests table heading row.
-        size_t r_col = 0;
-        size_t l_col = 0;
-        size_t a_col = 0;
-        size_t b_col = 0;
-        size_t s_col = 0;
-        size_t q_col = 0;
-        {
-            std::stringstream ss(lines[i]);
-
-            Vector<String> vals(6);
-            for (long j = 0; ss.good() && j < 6; j++)
-                ss >> vals[j];
-
-            {
-                const auto index = find(vals.cbegin(), vals.cend(), "R");
-                if (index == vals.cend())
-                {
-                    err("Cannot find R column in instance file");
-                }
-                r_col = index - vals.cbegin();
-            }
-            {
-                const auto index = find(vals.cbegin(), vals.cend(), "L");
-                if (index == vals.cend())
-                {
-                    err("Cannot find L column in instance file");
-                }
-                l_col = index - vals.cbegin();
-            }
-            {
-                const auto index = find(vals.cbegin(), vals.cend(), "A");
-                if (index == vals.cend())
-                {
-                    err("Cannot find A column in instance file");
-                }
-                a_col = index - vals.cbegin();
-            }
-            {
-                const auto index = find(vals.cbegin(), vals.cend(), "B");
-                if (index == vals.cend())
-                {
-                    err("Cannot find B column in instance file");
-                }
-                b_col = index - vals.cbegin();
-            }
-            {
-                const auto index = find(vals.cbegin(), vals.cend(), "S");
-                if (index == vals.cend())
-                {
-                    err("Cannot find S column in instance file");
-                }
-                s_col = index - vals.cbegin();
-            }
-            {
-                const auto index = find(vals.cbegin(), vals.cend(), "Q");
-                if (index == vals.cend())
-                {
-                    err("Cannot find Q column in instance file");
-                }
-                q_col = index - vals.cbegin();
-            }
-        }
+        const auto heading = read_columns<6>(line);
+        const auto r_col = find_column(heading, "R");
+        const auto l_col = find_column(heading, "L");
+        const auto a_col = find_column(heading, "A");
+        const auto b_col = find_column(heading, "B");
+        const auto s_col = find_column(heading, "S");
+        const auto q_col = find_column(heading, "Q");
 
         // Read requests table.
-        for (i++; i < lines.size() && lines[i].length() > 0; i++)
+        for (line = lines.next_line(); !line.empty(); line = lines.next_line())
         {
-            std::stringstream ss(lines[i]);
-
-            Vector<String> vals(6);
-            for (long j = 0; ss.good() && j < 6; j++)
-                ss >> vals[j];
-
-            r.push_back(move(vals[r_col]));
-            a.push_back(atoi(vals[a_col].c_str()));
-            b.push_back(atoi(vals[b_col].c_str()));
-            s.push_back(atoi(vals[s_col].c_str()));
-            q.push_back(atoi(vals[q_col].c_str()));
-
-            const auto index = find(loc_name.cbegin(), loc_name.cend(), vals[l_col]);
+            const auto vals = read_columns<6>(line);
+            r.emplace_back(vals[r_col]);
+            a.push_back(parse_int(vals[a_col]));
+            b.push_back(parse_int(vals[b_col]));
+            s.push_back(parse_int(vals[s_col]));
+            q.push_back(parse_int(vals[q_col]));
+
+            const auto index = std::find(loc_name.cbegin(), loc_name.cend(), vals[l_col]);
             if (index == loc_name.cend())
             {
                 err("Request {} has invalid location name {}", r.back(), vals[l_col]);
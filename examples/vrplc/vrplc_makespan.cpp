@@ -1,5 +1,6 @@
 #include "InstanceData.h"
 #include "Nutmeg/Nutmeg.h"
+#include "Nutmeg/SparseMatrix.h"
 
 int main(int argc, char** argv)
 {
@@ -29,7 +30,7 @@ int main(int argc, char** argv)
 #else
     err("Unspecified solving method");
 #endif
-    Matrix<BoolVar> vars_x;
+    SparseMatrix<BoolVar> vars_x;
     Vector<IntVar> vars_start;
     Vector<IntVar> vars_capacity;
 
@@ -46,14 +47,14 @@ int main(int argc, char** argv)
         }
 
     // Create edge variables.
-    vars_x.clear_and_resize(N, N);
+    vars_x = SparseMatrix<BoolVar>(is_valid);
     for (int i = 0; i <= R; ++i)
-        for (int j = 1; j <= R + 1; ++j)
-            if (is_valid(i, j))
-            {
-                const auto name = fmt::format("x[{},{}]", i, j);
-                vars_x(i, j) = model.add_bool_var(name);
-            }
+        for (auto k = vars_x.row_begin(i); k < vars_x.row_end(i); ++k)
+        {
+            const auto j = vars_x.col(k);
+            const auto name = fmt::format("x[{},{}]", i, j);
+            vars_x.value(k) = model.add_bool_var(name);
+        }
 
     // Create start time variables.
     vars_start.resize(N);
@@ -83,9 +84,8 @@ int main(int argc, char** argv)
     for (int i = 1; i <= R; ++i)
     {
         Vector<BoolVar> vars;
-        for (int j = 1; j <= R + 1; ++j)
-            if (is_valid(i, j))
-                vars.push_back(vars_x(i, j));
+        for (auto k = vars_x.row_begin(i); k < vars_x.row_end(i); ++k)
+            vars.push_back(vars_x.value(k));
         if (!vars.empty())
         {
             model.add_constr_set_partition(vars);
@@ -107,28 +107,28 @@ int main(int argc, char** argv)
     // x[i,j] -> start[i] + s[i] + cost[i,j] <= start[j]
     // x[i,j] -> start[i] - start[j] <= -s[i] - cost[i,j])
     for (int i = 0; i <= R; ++i)
-        for (int j = 1; j <= R + 1; ++j)
-            if (is_valid(i, j))
-            {
-                model.add_constr_reify_subtraction_leq(vars_x(i, j),
-                                                       vars_start[i],
-                                                       vars_start[j],
-                                                       -instance.s[i] - cost(i, j));
-            }
+        for (auto k = vars_x.row_begin(i); k < vars_x.row_end(i); ++k)
+        {
+            const auto j = vars_x.col(k);
+            model.add_constr_reify_subtraction_leq(vars_x.value(k),
+                                                   vars_start[i],
+                                                   vars_start[j],
+                                                   -instance.s[i] - cost(i, j));
+        }
 
     // Create vehicle capacity successor constraints.
     // x[i,j] -> capacity[i] + q[j] <= capacity[j]
     // x[i,j] -> capacity[i] - capacity[j] <= -q[j]
     for (int i = 0; i <= R; ++i)
-        for (int j = 1; j <= R + 1; ++j)
-            if (is_valid(i, j))
-            {
-                const auto q = std::abs(instance.q[j]);
-                model.add_constr_reify_subtraction_leq(vars_x(i, j),
-                                                       vars_capacity[i],
-                                                       vars_capacity[j],
-                                                       -q);
-            }
+        for (auto k = vars_x.row_begin(i); k < vars_x.row_end(i); ++k)
+        {
+            const auto j = vars_x.col(k);
+            const auto q = std::abs(instance.q[j]);
+            model.add_constr_reify_subtraction_leq(vars_x.value(k),
+                                                   vars_capacity[i],
+                                                   vars_capacity[j],
+                                                   -q);
+        }
 
     // Create scheduling constraints in CP.
     for (int l = 1; l <= L; ++l)
@@ -0,0 +1,199 @@
+#include "Nutmeg/Nutmeg.h"
+#include "Nutmeg/BatchSolver.h"
+#include "Nutmeg/ModelPool.h"
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+
+#define NB_INSTANCES                                    24 // number of generated instances
+#define NB_TASKS                                         8 // number of tasks in an instance
+#define NB_MACHINES                                      3 // number of machines in an instance
+#define HORIZON                                         24 // latest completion time of a task
+#define TIME_LIMIT                                    60.0 // time limit of each solve
+
+using namespace Nutmeg;
+
+struct Result
+{
+    Status status{Status::Unknown};
+    Int obj{0};
+};
+
+// Build a small assignment and scheduling model like ps_cost, generated from a seed
+static IntVar build(const Int seed, Model& model)
+{
+    // Generate instance.
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<Int> cost_dist(1, 20);
+    std::uniform_int_distribution<Int> duration_dist(2, 8);
+    std::uniform_int_distribution<Int> resource_dist(1, 3);
+    Vector<Vector<Int>> cost(NB_TASKS, Vector<Int>(NB_MACHINES));
+    Vector<Vector<Int>> duration(NB_TASKS, Vector<Int>(NB_MACHINES));
+    Vector<Vector<Int>> resource(NB_TASKS, Vector<Int>(NB_MACHINES));
+    for (Int t = 0; t < NB_TASKS; ++t)
+        for (Int m = 0; m < NB_MACHINES; ++m)
+        {
+            cost[t][m] = cost_dist(rng);
+            duration[t][m] = duration_dist(rng);
+            resource[t][m] = resource_dist(rng);
+        }
+    const Int capacity = 3;
+
+    // Create variables.
+    Vector<Vector<BoolVar>> assign(NB_TASKS);
+    Vector<Vector<IntVar>> start(NB_TASKS);
+    Int max_cost = 0;
+    for (Int t = 0; t < NB_TASKS; ++t)
+    {
+        for (Int m = 0; m < NB_MACHINES; ++m)
+        {
+            assign[t].push_back(model.add_bool_var(fmt::format("assign[{},{}]", t, m)));
+            start[t].push_back(model.add_int_var(0, HORIZON - duration[t][m], false, fmt::format("start[{},{}]", t, m)));
+        }
+        max_cost += *std::max_element(cost[t].begin(), cost[t].end());
+    }
+    const auto obj_var = model.add_int_var(0, max_cost, true, "cost");
+
+    // Create objective function.
+    {
+        Vector<BoolVar> vars;
+        Vector<Int> coeffs;
+        for (Int t = 0; t < NB_TASKS; ++t)
+            for (Int m = 0; m < NB_MACHINES; ++m)
+            {
+                vars.push_back(assign[t][m]);
+                coeffs.push_back(cost[t][m]);
+            }
+        model.add_constr_linear(vars, coeffs, Sign::EQ, 0, obj_var);
+    }
+
+    // Create assignment constraints.
+    for (Int t = 0; t < NB_TASKS; ++t)
+    {
+        model.add_constr_set_partition(assign[t]);
+    }
+
+    // Create scheduling constraints.
+    for (Int m = 0; m < NB_MACHINES; ++m)
+    {
+        Vector<BoolVar> active;
+        Vector<IntVar> loc_start;
+        Vector<Int> loc_duration;
+        Vector<Int> loc_resource;
+        for (Int t = 0; t < NB_TASKS; ++t)
+        {
+            active.push_back(assign[t][m]);
+            loc_start.push_back(start[t][m]);
+            loc_duration.push_back(duration[t][m]);
+            loc_resource.push_back(resource[t][m]);
+        }
+        model.add_constr_cumulative_optional(active, loc_start, loc_duration, loc_resource, capacity);
+    }
+
+    // Done.
+    return obj_var;
+}
+
+// Build and solve an instance in an empty model
+static Result solve(Model& model, const Int seed)
+{
+    const auto obj_var = build(seed, model);
+    model.minimize(obj_var, TIME_LIMIT, false);
+
+    Result result;
+    result.status = model.get_status();
+    if (result.status == Status::Optimal || result.status == Status::Feasible)
+    {
+        result.obj = model.get_primal_bound();
+    }
+    return result;
+}
+
+// Check that two results of the same instance agree. Only proven results are compared.
+static bool is_match(const Result& a, const Result& b)
+{
+    const auto is_proven = [](const Result& r) { return r.status == Status::Optimal || r.status == Status::Infeasible; };
+    return !is_proven(a) || !is_proven(b) || (a.status == b.status && a.obj == b.obj);
+}
+
+// Solve the same instances serially, on separate threads and with the batch solver, and fail if any
+// proven result differs
+int main()
+{
+    const auto nb_threads = std::max<Int>(2, std::thread::hardware_concurrency());
+
+    // Solve serially.
+    Vector<Result> serial_results(NB_INSTANCES);
+    {
+        ModelPool pool;
+        for (Int idx = 0; idx < NB_INSTANCES; ++idx)
+        {
+            auto model = pool.acquire(Method::BC);
+            serial_results[idx] = solve(*model, idx);
+            pool.release(std::move(model));
+        }
+    }
+
+    // Solve on separate threads.
+    Vector<Result> parallel_results(NB_INSTANCES);
+    {
+        std::atomic<Int> next_idx{0};
+        Vector<std::thread> threads;
+        for (Int thread_idx = 0; thread_idx < nb_threads; ++thread_idx)
+        {
+            threads.emplace_back([&]()
+            {
+                for (auto idx = next_idx++; idx < NB_INSTANCES; idx = next_idx++)
+                {
+                    Model model(Method::BC);
+                    parallel_results[idx] = solve(model, idx);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    // Solve with the batch solver.
+    Vector<Result> batch_results(NB_INSTANCES);
+    {
+        BatchSolver batch(nb_threads);
+        for (Int idx = 0; idx < NB_INSTANCES; ++idx)
+        {
+            batch.add_job(fmt::format("{}", idx), [idx](Model& model) { return build(idx, model); }, TIME_LIMIT);
+        }
+        batch.run([&](const BatchResult& result, Model&)
+        {
+            auto& batch_result = batch_results[result.job_idx];
+            batch_result.status = result.status;
+            if (result.status == Status::Optimal || result.status == Status::Feasible)
+            {
+                batch_result.obj = result.primal_bound;
+            }
+        });
+    }
+
+    // Compare.
+    Int nb_mismatches = 0;
+    for (Int idx = 0; idx < NB_INSTANCES; ++idx)
+    {
+        const auto& serial = serial_results[idx];
+        const auto& parallel = parallel_results[idx];
+        const auto& batch = batch_results[idx];
+        if (!is_match(serial, parallel) || !is_match(serial, batch) ||
+            batch.status == Status::Error || parallel.status == Status::Error)
+        {
+            println("Instance {}: serial {} {}, parallel {} {}, batch {} {}",
+                    idx,
+                    static_cast<Int>(serial.status), serial.obj,
+                    static_cast<Int>(parallel.status), parallel.obj,
+                    static_cast<Int>(batch.status), batch.obj);
+            ++nb_mismatches;
+        }
+    }
+    println("{} of {} instances mismatched", nb_mismatches, NB_INSTANCES);
+    return nb_mismatches == 0 ? 0 : 1;
+}